@@ -11,6 +11,7 @@
 #include "Variable.h"
 #include "common_types.h"
 #include <Rcpp.h>
+#include <algorithm>
 #include <queue>
 
 class CategoricalVariable;
@@ -40,6 +41,7 @@ public:
 
     virtual individual_index_t get_index_of(const std::vector<std::string>) const;
     virtual individual_index_t get_index_of(const std::string) const;
+    virtual const individual_index_t& get_category_index(const std::string&) const;
 
     virtual size_t get_size_of(const std::vector<std::string>) const;
     virtual size_t get_size_of(const std::string) const;
@@ -50,7 +52,14 @@ public:
     virtual void queue_shrink(const individual_index_t&);
     virtual const std::vector<std::string>& get_categories() const;
     virtual void resize() override;
+    virtual void apply_resize(const ResizePlan&) override;
+    virtual size_t get_extend_size() const override;
+    virtual size_t get_shrink_size() const override;
+    virtual size_t get_queue_size() const override;
     virtual size_t size() const override;
+    virtual Variable* clone() const override;
+    virtual void save(CheckpointWriter&) const override;
+    virtual void load(CheckpointReader&) override;
     virtual void update() override;
 };
 
@@ -96,6 +105,19 @@ inline individual_index_t CategoricalVariable::get_index_of(
     return individual_index_t(indices.at(category));
 }
 
+//' @title the individuals in a category, without copying them
+inline const individual_index_t& CategoricalVariable::get_category_index(
+        const std::string& category
+) const {
+    const auto it = indices.find(category);
+    if (it == indices.end()) {
+        std::stringstream message;
+        message << "unknown category: " << category;
+        Rcpp::stop(message.str());
+    }
+    return it->second;
+}
+
 //' @title return number of individuals whose value is in a set of categories
 inline size_t CategoricalVariable::get_size_of(
         const std::vector<std::string> categories        
@@ -133,6 +155,10 @@ inline void CategoricalVariable::queue_update(
         const std::string category,
         const individual_index_t& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->CategoricalVariable::queue_update(category, index); });
+        return;
+    }
     updates.push({ category, index });
 }
 
@@ -145,8 +171,9 @@ inline void CategoricalVariable::update() {
             if (entry.first == next.first) {
                 // destination state
                 entry.second |= next.second;
-            } else {
-                // other state
+            } else if (entry.second.intersects(next.second)) {
+                // other state, left alone if no one is leaving it so that
+                // it is not copied if it is shared with a clone
                 entry.second &= inverse_update;
             }
         }
@@ -158,6 +185,10 @@ inline void CategoricalVariable::update() {
 inline void CategoricalVariable::queue_extend(
     const std::vector<std::string>& new_values
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->CategoricalVariable::queue_extend(new_values); });
+        return;
+    }
     extend_values.insert(
         extend_values.cend(),
         new_values.cbegin(),
@@ -169,6 +200,10 @@ inline void CategoricalVariable::queue_extend(
 inline void CategoricalVariable::queue_shrink(
     const individual_index_t& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->CategoricalVariable::queue_shrink(index); });
+        return;
+    }
     if (index.max_size() != size()) {
         Rcpp::stop("Invalid bitset size for variable shrink");
     }
@@ -179,6 +214,10 @@ inline void CategoricalVariable::queue_shrink(
 inline void CategoricalVariable::queue_shrink(
     const std::vector<size_t>& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->CategoricalVariable::queue_shrink(index); });
+        return;
+    }
     for (const auto& x : index) {
         if (x >= size()) {
             Rcpp::stop("Invalid vector index for variable shrink");
@@ -187,44 +226,152 @@ inline void CategoricalVariable::queue_shrink(
     shrink_index.insert(index.cbegin(), index.cend());
 }
 
+//' @title apply the queued shrinks and extensions
+//' @description without tombstones, removed individuals are shrunk away and
+//' new individuals appended directly; a ResizePlan is only made when the
+//' tombstones allocate the slots
 inline void CategoricalVariable::resize() {
-    auto size_changed = false;
+    if (shrink_index.size() == 0 && extend_values.size() == 0) {
+        return;
+    }
+    if (tombstones.enabled()) {
+        apply_resize(ResizePlan(shrink_index, extend_values.size(), tombstones));
+        return;
+    }
 
     // Apply shrink updates
     if (shrink_index.size() > 0) {
-        auto index = std::vector<size_t>(
+        const auto index = std::vector<size_t>(
             shrink_index.cbegin(),
             shrink_index.cend()
         );
         for (auto& entry : indices) {
             entry.second.shrink(index);
         }
-        shrink_index.clear();
-        size_changed = true;
     }
 
     // Apply extension updates
-    if (extend_values.size() > 0) {
-        auto shrunk_size = size();
+    const auto shrunk_size = size();
+    for (auto& entry : indices) {
+        entry.second.extend(extend_values.size());
+    }
+    for (auto i = 0u; i < extend_values.size(); ++i) {
+        indices.at(extend_values[i]).insert(shrunk_size + i);
+    }
+    extend_values.clear();
+    shrink_index = individual_index_t(size());
+}
+
+//' @title resize with a plan, the variable's own queued shrinks are discarded
+inline void CategoricalVariable::apply_resize(const ResizePlan& plan) {
+    if (!plan.empty()) {
+        // Apply shrink updates
+        if (plan.tombstones != nullptr) {
+            const auto not_removed = !plan.removed;
+            for (auto& entry : indices) {
+                entry.second &= not_removed;
+            }
+        } else if (!plan.removed_vector.empty()) {
+            for (auto& entry : indices) {
+                entry.second.shrink(plan.removed_vector);
+            }
+        }
+
+        // Apply extension updates
+        const auto n_appended = plan.allocated_size - size();
         for (auto& entry : indices) {
-            entry.second.extend(extend_values.size());
+            entry.second.extend(n_appended);
         }
-        for (auto i = 0u; i < extend_values.size(); ++i) {
-            indices.at(extend_values[i]).insert(shrunk_size + i);
+        for (auto i = 0u; i < plan.slots.size(); ++i) {
+            indices.at(extend_values[i]).insert(plan.slots[i]);
         }
         extend_values.clear();
-        size_changed = true;
-    }
 
-    if (size_changed) {
-        shrink_index = individual_index_t(size());
+        if (!plan.compacted_vector.empty()) {
+            for (auto& entry : indices) {
+                entry.second.shrink(plan.compacted_vector);
+            }
+        }
+        follow_tombstones(plan);
     }
+    shrink_index = individual_index_t(size());
+}
+
+inline size_t CategoricalVariable::get_extend_size() const {
+    return extend_values.size();
+}
+
+inline size_t CategoricalVariable::get_shrink_size() const {
+    return shrink_index.size();
+}
+
+inline size_t CategoricalVariable::get_queue_size() const {
+    return updates.size();
 }
 
 inline size_t CategoricalVariable::size() const {
     return indices.begin()->second.max_size();
 }
 
+inline Variable* CategoricalVariable::clone() const {
+    return new CategoricalVariable(*this);
+}
+
+//' @title write the variable's state, see Checkpoint.h
+inline void CategoricalVariable::save(CheckpointWriter& out) const {
+    out.write_tag("CategoricalVariable");
+    out.write(categories);
+    for (const auto& category : categories) {
+        out.write(indices.at(category));
+    }
+    write_queue(out, updates, [&](const update_t& update) {
+        out.write(update.first);
+        out.write(update.second);
+    });
+    out.write(shrink_index);
+    out.write(extend_values);
+    tombstones.save(out);
+}
+
+//' @title replace the variable's state, the categories must be the same
+inline void CategoricalVariable::load(CheckpointReader& in) {
+    in.expect_tag("CategoricalVariable");
+    auto saved_categories = std::vector<std::string>();
+    in.read(saved_categories);
+    if (saved_categories != categories) {
+        Rcpp::stop("checkpoint has different categories to the variable");
+    }
+    for (const auto& category : categories) {
+        in.read(indices.at(category));
+        expect_consistent(
+            indices.at(category).max_size() == size(),
+            "CategoricalVariable"
+        );
+    }
+    const auto is_category = [&](const std::string& category) {
+        return indices.find(category) != indices.end();
+    };
+    read_queue(in, updates, [&]() {
+        auto update = update_t("", individual_index_t(0));
+        in.read(update.first);
+        in.read(update.second);
+        expect_consistent(
+            is_category(update.first) && update.second.max_size() == size(),
+            "CategoricalVariable"
+        );
+        return update;
+    });
+    in.read(shrink_index);
+    in.read(extend_values);
+    tombstones.load(in);
+    expect_consistent(
+        shrink_index.max_size() == size() &&
+            std::all_of(extend_values.cbegin(), extend_values.cend(), is_category) &&
+            tombstones.consistent(size()),
+        "CategoricalVariable"
+    );
+}
+
 inline const std::vector<std::string>& CategoricalVariable::get_categories() const {
     return categories;
 }
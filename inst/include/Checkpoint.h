@@ -0,0 +1,393 @@
+/*
+ * Checkpoint.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_CHECKPOINT_H_
+#define INST_INCLUDE_CHECKPOINT_H_
+
+#include "common_types.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//' @title the version of the checkpoint format
+//' @description increment this whenever what a structure saves changes
+constexpr uint32_t checkpoint_version = 1;
+
+//' @title the first bytes of a checkpoint file
+constexpr char checkpoint_magic[8] = { 'I', 'N', 'D', 'V', 'C', 'K', 'P', 'T' };
+
+//' @title write a checkpoint of simulation state to a binary file
+//' @description A checkpoint is a header, with the format version and a
+//' marker of the machine's byte order, followed by each structure's state in
+//' the order it was saved. Each structure starts with a tag naming its type,
+//' and numbers are written with their size and kind, so that restoring into a
+//' different structure stops rather than reading garbage. Arrays are written
+//' in one block, padded to 8 bytes so that every array is aligned in the file,
+//' and are read back in one block.
+//' It contains the following data members:
+//'     * out: the file
+//'     * position: the number of bytes written
+class CheckpointWriter {
+    std::ofstream out;
+    size_t position = 0;
+
+    void write_bytes(const void*, size_t);
+    void pad();
+
+public:
+    CheckpointWriter(const std::string& path);
+    virtual ~CheckpointWriter() = default;
+
+    template<class T>
+    void write(const T&);
+    template<class T>
+    void write(const std::vector<T>&);
+    template<class T>
+    void write(const std::vector<std::vector<T>>&);
+    void write(const std::string&);
+    void write(const std::vector<std::string>&);
+    void write(const individual_index_t&);
+    template<class T>
+    void write_type();
+    void write_tag(const std::string&);
+    virtual void close();
+};
+
+//' @title read a checkpoint written by CheckpointWriter
+//' @description the header is checked when the file is opened
+//' It contains the following data members:
+//'     * in: the file
+//'     * size: the size of the file in bytes
+//'     * position: the number of bytes read
+class CheckpointReader {
+    std::ifstream in;
+    size_t size = 0;
+    size_t position = 0;
+
+    void read_bytes(void*, size_t);
+    void skip_padding();
+
+public:
+    CheckpointReader(const std::string& path);
+    virtual ~CheckpointReader() = default;
+
+    uint64_t read_length(size_t element_size);
+    template<class T>
+    void read(T&);
+    template<class T>
+    void read(std::vector<T>&);
+    template<class T>
+    void read(std::vector<std::vector<T>>&);
+    void read(std::string&);
+    void read(std::vector<std::string>&);
+    void read(individual_index_t&);
+    template<class T>
+    void expect_type();
+    void expect_tag(const std::string&);
+    virtual void close();
+};
+
+//' @title the byte order of this machine, as written in the header
+constexpr uint32_t checkpoint_byte_order = 0x01020304;
+
+//' @title a description of a number type, so that types can be checked
+inline uint32_t checkpoint_type_code(size_t size, bool floating, bool is_signed) {
+    return static_cast<uint32_t>(size) | (floating ? 0x100u : 0u) | (is_signed ? 0x200u : 0u);
+}
+
+inline CheckpointWriter::CheckpointWriter(const std::string& path)
+    : out(path, std::ios::binary | std::ios::trunc) {
+    if (!out) {
+        Rcpp::stop("could not open checkpoint file for writing: " + path);
+    }
+    write_bytes(checkpoint_magic, sizeof(checkpoint_magic));
+    write(checkpoint_version);
+    write(checkpoint_byte_order);
+}
+
+inline void CheckpointWriter::write_bytes(const void* data, size_t n) {
+    out.write(static_cast<const char*>(data), n);
+    if (!out) {
+        Rcpp::stop("could not write checkpoint");
+    }
+    position += n;
+}
+
+//' @title pad to the next multiple of 8 bytes
+inline void CheckpointWriter::pad() {
+    static const char zeros[8] = { 0 };
+    if (position % 8 != 0) {
+        write_bytes(zeros, 8 - position % 8);
+    }
+}
+
+//' @title write a number, or another trivially copyable value
+template<class T>
+inline void CheckpointWriter::write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+    write_bytes(&value, sizeof(T));
+}
+
+//' @title write an array in one block
+template<class T>
+inline void CheckpointWriter::write(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+    write(static_cast<uint64_t>(values.size()));
+    pad();
+    if (!values.empty()) {
+        write_bytes(values.data(), values.size() * sizeof(T));
+    }
+}
+
+template<class T>
+inline void CheckpointWriter::write(const std::vector<std::vector<T>>& values) {
+    write(static_cast<uint64_t>(values.size()));
+    for (const auto& row : values) {
+        write(row);
+    }
+}
+
+inline void CheckpointWriter::write(const std::string& value) {
+    write(static_cast<uint64_t>(value.size()));
+    write_bytes(value.data(), value.size());
+}
+
+inline void CheckpointWriter::write(const std::vector<std::string>& values) {
+    write(static_cast<uint64_t>(values.size()));
+    for (const auto& value : values) {
+        write(value);
+    }
+}
+
+//' @title write a bitset's size and words
+inline void CheckpointWriter::write(const individual_index_t& bitset) {
+    write(static_cast<uint64_t>(bitset.max_size()));
+    write(bitset.words());
+}
+
+template<class T>
+inline void CheckpointWriter::write_type() {
+    write(checkpoint_type_code(
+        sizeof(T),
+        std::is_floating_point<T>::value,
+        std::is_signed<T>::value
+    ));
+}
+
+//' @title name the structure which is written next
+inline void CheckpointWriter::write_tag(const std::string& tag) {
+    write(tag);
+}
+
+inline void CheckpointWriter::close() {
+    out.close();
+    if (!out) {
+        Rcpp::stop("could not write checkpoint");
+    }
+}
+
+inline CheckpointReader::CheckpointReader(const std::string& path)
+    : in(path, std::ios::binary) {
+    if (!in) {
+        Rcpp::stop("could not open checkpoint file for reading: " + path);
+    }
+    in.seekg(0, std::ios::end);
+    size = static_cast<size_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+    char magic[sizeof(checkpoint_magic)];
+    read_bytes(magic, sizeof(magic));
+    if (std::memcmp(magic, checkpoint_magic, sizeof(magic)) != 0) {
+        Rcpp::stop("not a checkpoint file: " + path);
+    }
+    auto version = uint32_t(0);
+    read(version);
+    if (version != checkpoint_version) {
+        Rcpp::stop(
+            "checkpoint version " + std::to_string(version) +
+            " cannot be read by this version, which reads version " +
+            std::to_string(checkpoint_version)
+        );
+    }
+    auto byte_order = uint32_t(0);
+    read(byte_order);
+    if (byte_order != checkpoint_byte_order) {
+        Rcpp::stop("checkpoint was written on a machine with a different byte order");
+    }
+}
+
+inline void CheckpointReader::read_bytes(void* data, size_t n) {
+    in.read(static_cast<char*>(data), n);
+    if (!in) {
+        Rcpp::stop("checkpoint is truncated");
+    }
+    position += n;
+}
+
+inline void CheckpointReader::skip_padding() {
+    char padding[8];
+    if (position % 8 != 0) {
+        read_bytes(padding, 8 - position % 8);
+    }
+}
+
+//' @title read the length of a sequence
+//' @description the length is checked against the bytes left in the file
+//' before anything is allocated for it, so a corrupt length is an error
+//' rather than a huge allocation
+//' @param element_size the fewest bytes each element takes in the file
+inline uint64_t CheckpointReader::read_length(size_t element_size) {
+    auto n = uint64_t(0);
+    read(n);
+    if (element_size > 0 && n > (size - position) / element_size) {
+        Rcpp::stop("checkpoint is truncated");
+    }
+    return n;
+}
+
+template<class T>
+inline void CheckpointReader::read(T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+    read_bytes(&value, sizeof(T));
+}
+
+template<class T>
+inline void CheckpointReader::read(std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+    const auto n = read_length(sizeof(T));
+    skip_padding();
+    values.resize(n);
+    if (n > 0) {
+        read_bytes(values.data(), n * sizeof(T));
+    }
+}
+
+template<class T>
+inline void CheckpointReader::read(std::vector<std::vector<T>>& values) {
+    const auto n = read_length(sizeof(uint64_t));
+    values.resize(n);
+    for (auto& row : values) {
+        read(row);
+    }
+}
+
+inline void CheckpointReader::read(std::string& value) {
+    const auto n = read_length(1);
+    value.resize(n);
+    if (n > 0) {
+        read_bytes(&value[0], n);
+    }
+}
+
+inline void CheckpointReader::read(std::vector<std::string>& values) {
+    const auto n = read_length(sizeof(uint64_t));
+    values.resize(n);
+    for (auto& value : values) {
+        read(value);
+    }
+}
+
+//' @title read a bitset, replacing its size and elements
+inline void CheckpointReader::read(individual_index_t& bitset) {
+    auto size = uint64_t(0);
+    read(size);
+    auto words = std::vector<uint64_t>();
+    read(words);
+    if (words.size() != size / 64 + 1) {
+        Rcpp::stop("checkpoint has a corrupt bitset");
+    }
+    bitset = individual_index_t(size);
+    bitset.assign_words([&](size_t i) { return words[i]; });
+}
+
+template<class T>
+inline void CheckpointReader::expect_type() {
+    auto code = uint32_t(0);
+    read(code);
+    const auto expected = checkpoint_type_code(
+        sizeof(T),
+        std::is_floating_point<T>::value,
+        std::is_signed<T>::value
+    );
+    if (code != expected) {
+        Rcpp::stop("checkpoint stores values of a different type");
+    }
+}
+
+//' @title check that the structure read next is the one being restored
+inline void CheckpointReader::expect_tag(const std::string& tag) {
+    auto found = std::string();
+    read(found);
+    if (found != tag) {
+        Rcpp::stop("checkpoint has a " + found + " where a " + tag + " was expected");
+    }
+}
+
+//' @title check that the whole checkpoint has been read
+inline void CheckpointReader::close() {
+    if (in.peek() != std::char_traits<char>::eof()) {
+        Rcpp::stop("checkpoint has more structures than were restored");
+    }
+    in.close();
+}
+
+//' @title write a queue, which has no iterators, from a copy
+template<class T, class F>
+inline void write_queue(CheckpointWriter& out, std::queue<T> queue, F write_item) {
+    out.write(static_cast<uint64_t>(queue.size()));
+    while (!queue.empty()) {
+        write_item(queue.front());
+        queue.pop();
+    }
+}
+
+//' @title read a queue written by write_queue, replacing its contents
+template<class T, class F>
+inline void read_queue(CheckpointReader& in, std::queue<T>& queue, F read_item) {
+    const auto n = in.read_length(1);
+    queue = std::queue<T>();
+    for (auto i = 0u; i < n; ++i) {
+        queue.push(read_item());
+    }
+}
+
+//' @title stop if a structure read from a checkpoint breaks its invariants
+//' @param consistent whether the invariants hold
+//' @param structure the kind of structure, for the error
+inline void expect_consistent(bool consistent, const std::string& structure) {
+    if (!consistent) {
+        Rcpp::stop("checkpoint has a corrupt " + structure);
+    }
+}
+
+//' @title are all of the individuals in an index below `size`?
+inline bool indices_below(const std::vector<size_t>& index, size_t size) {
+    return std::all_of(index.cbegin(), index.cend(), [=](size_t i) {
+        return i < size;
+    });
+}
+
+//' @title could a queued update have been queued on a structure of `size`?
+//' @description an update gives a value for each individual in its index,
+//' or one value for all of them, and an empty index means every individual
+//' @param n_values the number of values in the update
+//' @param index the individuals to update
+//' @param size the size of the structure
+inline bool queued_update_fits(
+    size_t n_values,
+    const std::vector<size_t>& index,
+    size_t size
+) {
+    const auto n_updated = index.empty() ? size : index.size();
+    return indices_below(index, size) && (n_values == 1 || n_values == n_updated);
+}
+
+#endif /* INST_INCLUDE_CHECKPOINT_H_ */
@@ -0,0 +1,290 @@
+/*
+ * CompactVariable.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_COMPACT_VARIABLE_H_
+#define INST_INCLUDE_COMPACT_VARIABLE_H_
+
+#include "DoubleVariable.h"
+#include "IntegerVariable.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+//' @title check that a value can be stored in an integral type S
+template<class S, class A>
+inline bool representable(const A v, std::true_type) {
+    return !(v < std::numeric_limits<S>::min()) && !(std::numeric_limits<S>::max() < v);
+}
+
+//' @title check that a value can be stored in a floating point type S
+//' @description non-finite values (including NA) are kept, finite values must
+//' not overflow
+template<class S, class A>
+inline bool representable(const A v, std::false_type) {
+    return !std::isfinite(v) || !(std::numeric_limits<S>::max() < std::abs(v));
+}
+
+template<class S, class A>
+inline bool representable(const A v) {
+    return representable<S>(v, std::is_integral<S>());
+}
+
+//' @title a numeric variable with compact storage
+//' @description This class stores values as S, a narrower type than the
+//' type A which is used for updates and queries, e.g. float for a
+//' DoubleVariable or int8_t for an IntegerVariable. Values are converted to A
+//' when read. Values which cannot be stored in S are rejected when they are
+//' queued. It inherits from Base, which must be a NumericVariable<A>, and
+//' leaves Base's values empty.
+//' It contains the following data members:
+//'     * compact_values: a vector of values, shared with copies of the
+//'     variable until either changes, see CopyOnWrite.h
+template <class A, class S, class Base = NumericVariable<A>>
+class CompactNumericVariable : public Base {
+
+protected:
+    CopyOnWrite<std::vector<S>> compact_values;
+    void check_storage(const std::vector<A>&) const;
+    virtual void save_values(CheckpointWriter&) const override;
+    virtual void load_values(CheckpointReader&) override;
+
+public:
+    CompactNumericVariable(const std::vector<A>& values);
+    virtual ~CompactNumericVariable() = default;
+
+    virtual std::vector<A> get_values() const override;
+    virtual std::vector<A> get_values(const individual_index_t& index) const override;
+    virtual std::vector<A> get_values(const std::vector<size_t>& index) const override;
+    virtual std::shared_ptr<ValuesView<A>> get_values_view() const override;
+
+    virtual individual_index_t get_index_of_range(const A a, const A b) const override;
+    virtual size_t get_size_of_range(const A a, const A b) const override;
+
+    virtual void queue_update(const std::vector<A>& values, const std::vector<size_t>& index) override;
+    virtual void queue_extend(const std::vector<A>&) override;
+    virtual void resize() override;
+    virtual void apply_resize(const ResizePlan&) override;
+    virtual size_t size() const override;
+    virtual Variable* clone() const override;
+
+    virtual void update() override;
+};
+
+template<class A, class S, class Base>
+inline CompactNumericVariable<A, S, Base>::CompactNumericVariable(
+    const std::vector<A>& values
+) : Base(std::vector<A>()) {
+    check_storage(values);
+    compact_values = std::vector<S>(values.cbegin(), values.cend());
+    this->shrink_index = individual_index_t(size());
+}
+
+//' @title stop if any values cannot be stored
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::check_storage(
+    const std::vector<A>& values
+) const {
+    for (const auto& v : values) {
+        if (!representable<S>(v)) {
+            std::stringstream message;
+            message << "value out of range for variable storage type: " << v;
+            Rcpp::stop(message.str());
+        }
+    }
+}
+
+//' @title get all values
+template<class A, class S, class Base>
+inline std::vector<A> CompactNumericVariable<A, S, Base>::get_values() const {
+    const auto& values = compact_values.read();
+    return std::vector<A>(values.cbegin(), values.cend());
+}
+
+//' @title get values at index given by a bitset
+template<class A, class S, class Base>
+inline std::vector<A> CompactNumericVariable<A, S, Base>::get_values(
+    const individual_index_t& index
+) const {
+    return vector_get_values<A>(compact_values.read(), index);
+}
+
+//' @title get values at index given by a vector
+template<class A, class S, class Base>
+inline std::vector<A> CompactNumericVariable<A, S, Base>::get_values(
+    const std::vector<size_t>& index
+) const {
+    return vector_get_values<A>(compact_values.read(), index);
+}
+
+//' @title get a read-only view of all values
+//' @description values are converted as they are read from the view
+template<class A, class S, class Base>
+inline std::shared_ptr<ValuesView<A>> CompactNumericVariable<A, S, Base>::get_values_view() const {
+    auto view = std::make_shared<VectorView<A, S>>(compact_values.read());
+    this->views.add(view);
+    return view;
+}
+
+//' @title return bitset giving index of individuals whose value is in some range [a,b]
+template<class A, class S, class Base>
+inline individual_index_t CompactNumericVariable<A, S, Base>::get_index_of_range(
+    const A a, const A b
+) const {
+    return vector_index_where(compact_values.read(), this->tombstones, in_range<A>{ a, b });
+}
+
+//' @title return number of individuals whose value is in some range [a,b]
+template<class A, class S, class Base>
+inline size_t CompactNumericVariable<A, S, Base>::get_size_of_range(
+    const A a, const A b
+) const {
+    return vector_count_where(compact_values.read(), this->tombstones, in_range<A>{ a, b });
+}
+
+//' @title queue a state update for some subset of individuals
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::queue_update(
+    const std::vector<A>& values,
+    const std::vector<size_t>& index
+) {
+    check_storage(values);
+    Base::queue_update(values, index);
+}
+
+//' @title queue new values to add to the variable
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::queue_extend(
+    const std::vector<A>& new_values
+) {
+    check_storage(new_values);
+    Base::queue_extend(new_values);
+}
+
+//' @title apply all queued state updates in FIFO order
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::update() {
+    if (this->updates.size() > 0) {
+        this->views.detach();
+        ++this->version;
+        vector_update(this->updates, compact_values.write());
+    }
+}
+
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::resize() {
+    if (this->shrink_index.size() == 0 && this->extend_values.size() == 0) {
+        return;
+    }
+    if (this->tombstones.enabled()) {
+        apply_resize(ResizePlan(
+            this->shrink_index,
+            this->extend_values.size(),
+            this->tombstones
+        ));
+        return;
+    }
+    this->views.detach();
+    ++this->version;
+    resize_vector(compact_values.write(), this->shrink_index, this->extend_values);
+    this->shrink_index.reset(size());
+}
+
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::apply_resize(const ResizePlan& plan) {
+    if (!plan.empty()) {
+        this->views.detach();
+        ++this->version;
+        resize_vector(compact_values.write(), plan, this->extend_values);
+        this->follow_tombstones(plan);
+    }
+    this->shrink_index.reset(size());
+}
+
+//' @title write the values in their storage type
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::save_values(CheckpointWriter& out) const {
+    out.write_type<S>();
+    out.write(compact_values.read());
+}
+
+template<class A, class S, class Base>
+inline void CompactNumericVariable<A, S, Base>::load_values(CheckpointReader& in) {
+    in.expect_type<S>();
+    auto loaded = std::vector<S>();
+    in.read(loaded);
+    compact_values = std::move(loaded);
+}
+
+template<class A, class S, class Base>
+inline size_t CompactNumericVariable<A, S, Base>::size() const {
+    return compact_values.read().size();
+}
+
+template<class A, class S, class Base>
+inline Variable* CompactNumericVariable<A, S, Base>::clone() const {
+    return new CompactNumericVariable<A, S, Base>(*this);
+}
+
+template<class S>
+using CompactDoubleVariable = CompactNumericVariable<double, S, DoubleVariable>;
+
+//' @title an integer variable with compact storage
+//' @description values are stored as S, e.g. int8_t or int16_t
+template<class S>
+struct CompactIntegerVariable : public CompactNumericVariable<int, S, IntegerVariable> {
+    CompactIntegerVariable(const std::vector<int>& values);
+    virtual ~CompactIntegerVariable() = default;
+    virtual Variable* clone() const override;
+    virtual individual_index_t get_index_of_set(const std::vector<int>&) const override;
+    virtual individual_index_t get_index_of_set(const int) const override;
+
+    virtual size_t get_size_of_set(const std::vector<int>&) const override;
+    virtual size_t get_size_of_set(const int) const override;
+};
+
+template<class S>
+inline CompactIntegerVariable<S>::CompactIntegerVariable(const std::vector<int>& values)
+    : CompactNumericVariable<int, S, IntegerVariable>(values) {}
+
+template<class S>
+inline Variable* CompactIntegerVariable<S>::clone() const {
+    return new CompactIntegerVariable<S>(*this);
+}
+
+//' @title return bitset giving index of individuals whose value is in a finite set
+template<class S>
+inline individual_index_t CompactIntegerVariable<S>::get_index_of_set(
+    const std::vector<int>& values_set
+) const {
+    return vector_index_where(this->compact_values.read(), this->tombstones, in_set<int>{ values_set });
+}
+
+//' @title return bitset giving index of individuals whose value is equal to a specific scalar
+template<class S>
+inline individual_index_t CompactIntegerVariable<S>::get_index_of_set(
+    const int value
+) const {
+    return vector_index_where(this->compact_values.read(), this->tombstones, equal_to_value<int>{ value });
+}
+
+//' @title return number of individuals whose value is in a finite set
+template<class S>
+inline size_t CompactIntegerVariable<S>::get_size_of_set(
+    const std::vector<int>& values_set
+) const {
+    return vector_count_where(this->compact_values.read(), this->tombstones, in_set<int>{ values_set });
+}
+
+//' @title return number of individuals whose value is equal to a specific scalar
+template<class S>
+inline size_t CompactIntegerVariable<S>::get_size_of_set(
+    const int value
+) const {
+    return vector_count_where(this->compact_values.read(), this->tombstones, equal_to_value<int>{ value });
+}
+
+#endif /* INST_INCLUDE_COMPACT_VARIABLE_H_ */
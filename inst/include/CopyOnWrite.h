@@ -0,0 +1,82 @@
+/*
+ * CopyOnWrite.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_COPY_ON_WRITE_H_
+#define INST_INCLUDE_COPY_ON_WRITE_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+//' @title storage shared between copies until one of them changes it
+//' @description Copies of a CopyOnWrite share one value, so copying a bitset or
+//' a variable, for example to fork a simulation after burn-in, costs nothing
+//' until one of the copies is changed. `write` gives the caller its own copy
+//' of the value if the value is shared, and must be called before each change,
+//' on the thread which owns the copy. Reads may happen on any thread.
+//' It contains the following data members:
+//'     * value: the value, shared with any copies
+template<class T>
+class CopyOnWrite {
+    std::shared_ptr<T> value;
+
+public:
+    CopyOnWrite();
+    CopyOnWrite(T);
+    CopyOnWrite& operator=(T);
+
+    const T& read() const;
+    T& write();
+    bool shared() const;
+};
+
+template<class T>
+inline CopyOnWrite<T>::CopyOnWrite() : value(std::make_shared<T>()) {}
+
+template<class T>
+inline CopyOnWrite<T>::CopyOnWrite(T initial)
+    : value(std::make_shared<T>(std::move(initial))) {}
+
+//' @title replace the value
+//' @description copies which shared the old value keep it
+template<class T>
+inline CopyOnWrite<T>& CopyOnWrite<T>::operator=(T replacement) {
+    if (shared()) {
+        value = std::make_shared<T>(std::move(replacement));
+    } else {
+        *value = std::move(replacement);
+    }
+    return *this;
+}
+
+template<class T>
+inline const T& CopyOnWrite<T>::read() const {
+    return *value;
+}
+
+//' @title the value, ready to be changed
+//' @description copies the value first if another copy shares it
+template<class T>
+inline T& CopyOnWrite<T>::write() {
+    if (shared()) {
+        value = std::make_shared<T>(*value);
+    }
+    return *value;
+}
+
+//' @title whether another copy shares the value
+//' @description if not, the fence orders any reads by a copy which has just
+//' stopped sharing the value, on another thread, before our changes to it
+template<class T>
+inline bool CopyOnWrite<T>::shared() const {
+    if (value.use_count() > 1) {
+        return true;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return false;
+}
+
+#endif /* INST_INCLUDE_COPY_ON_WRITE_H_ */
@@ -9,11 +9,14 @@
 #define INST_INCLUDE_EVENT_H_
 
 #include "common_types.h"
+#include "ResizePlan.h"
+#include "Staging.h"
+#include "TimingWheel.h"
+#include "Checkpoint.h"
 #include <Rcpp.h>
 #include <set>
 #include <map>
 #include <functional>
-#include <unordered_set>
 #include <queue>
 
 using listener_t = std::function<void (size_t)>;
@@ -44,6 +47,9 @@ class EventBase {
 public:
     virtual void tick();
     virtual size_t get_time() const;
+    virtual EventBase* clone() const;
+    virtual void save(CheckpointWriter&) const;
+    virtual void load(CheckpointReader&);
     
     virtual bool should_trigger() = 0;
     virtual ~EventBase() = default;
@@ -58,6 +64,25 @@ inline size_t EventBase::get_time() const {
     return t;
 }
 
+//' @title a copy of the event, including its schedule
+//' @description events which can be cloned override this. The bitsets of a
+//' clone's schedule are shared with the original until either changes
+inline EventBase* EventBase::clone() const {
+    Rcpp::stop("this event cannot be cloned");
+}
+
+//' @title write the event's time step, which events extend with their
+//' schedule, see Checkpoint.h
+inline void EventBase::save(CheckpointWriter& out) const {
+    out.write(static_cast<uint64_t>(t));
+}
+
+inline void EventBase::load(CheckpointReader& in) {
+    auto saved = uint64_t(0);
+    in.read(saved);
+    t = saved;
+}
+
 
 //' @title a general event in the simulation
 //' @description This class provides functionality for general events which are 
@@ -78,6 +103,9 @@ public:
 
     virtual void schedule(std::vector<double> delays);
     virtual void clear_schedule();
+    virtual EventBase* clone() const override;
+    virtual void save(CheckpointWriter&) const override;
+    virtual void load(CheckpointReader&) override;
     
 };
 
@@ -86,6 +114,24 @@ inline void Event::process(Rcpp::XPtr<listener_t> listener) {
     (*listener)(get_time());
 }
 
+inline EventBase* Event::clone() const {
+    return new Event(*this);
+}
+
+inline void Event::save(CheckpointWriter& out) const {
+    out.write_tag("Event");
+    EventBase::save(out);
+    out.write(std::vector<uint64_t>(simple_schedule.cbegin(), simple_schedule.cend()));
+}
+
+inline void Event::load(CheckpointReader& in) {
+    in.expect_tag("Event");
+    EventBase::load(in);
+    auto saved = std::vector<uint64_t>();
+    in.read(saved);
+    simple_schedule = std::set<size_t>(saved.cbegin(), saved.cend());
+}
+
 //' @title should first event fire on this timestep?
 inline bool Event::should_trigger() {
     return *simple_schedule.begin() == get_time();
@@ -99,6 +145,10 @@ inline void Event::tick() {
 
 //' @title schedule a vector of events
 inline void Event::schedule(std::vector<double> delays) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->Event::schedule(delays); });
+        return;
+    }
     for (auto delay : round_delay(delays)) {
         simple_schedule.insert(get_time() + delay);
     }
@@ -106,6 +156,10 @@ inline void Event::schedule(std::vector<double> delays) {
 
 //' @title clear all scheduled events
 inline void Event::clear_schedule() {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->Event::clear_schedule(); });
+        return;
+    }
     simple_schedule.clear();
 }
 
@@ -114,16 +168,34 @@ inline void Event::clear_schedule() {
 //' @description This class provides functionality for targeted events which are 
 //' applied to a subset of individuals in the simulation. It inherits from EventBase.
 //' It contains the following data members:
-//'     * targeted_schedule: a map of times and bitsets of scheduled individuals
-//'     * extensions: a queue of extension operations
+//'     * targeted_schedule: a timing wheel of the individuals scheduled for
+//'     each timestep, see TimingWheel
+//'     * extensions: the numbers of new individuals and their delays, in the
+//'     order they were queued
 //'     * shrink_index: an index of individuals to remove
 //'     * size: size of population
+//'     * tombstones: free slots, if tombstones are enabled
+//'     * indexed, index: the timesteps each individual is scheduled for, if
+//'     the reverse index is enabled, see ScheduleIndex
+//'     * target: the individuals scheduled for the current timestep, made
+//'     from the timing wheel by current_target
 class TargetedEvent : public EventBase {
 
+    using extension_t = std::pair<size_t, std::vector<double>>;
     size_t _size = 0;
-    std::map<size_t, individual_index_t> targeted_schedule;
-    std::queue<std::function<void ()>> extensions;
+    TimingWheel targeted_schedule;
+    std::vector<extension_t> extensions;
     individual_index_t shrink_index;
+    Tombstones tombstones;
+    bool indexed = false;
+    ScheduleIndex index = ScheduleIndex(0);
+    individual_index_t target;
+
+    ScheduleSlot& get_timestep(size_t);
+    template<class T>
+    void clear_indexed(const T&);
+    template<class F>
+    void for_each_timestep(const std::vector<size_t>&, F);
 
 public:
     TargetedEvent(size_t);
@@ -151,21 +223,104 @@ public:
     virtual void queue_extend(const std::vector<double>&);
     virtual size_t size() const;
     virtual void resize();
+    virtual void apply_resize(const ResizePlan&);
+    virtual size_t get_extend_size() const;
+    virtual size_t get_shrink_size() const;
+    virtual void enable_tombstones(const double threshold);
+    virtual const Tombstones& get_tombstones() const;
+    virtual void enable_reverse_index();
 
     virtual void clear_schedule(const individual_index_t&);
+    virtual void clear_schedule(const std::vector<size_t>&);
     virtual individual_index_t get_scheduled() const;
+    virtual EventBase* clone() const override;
+    virtual void save(CheckpointWriter&) const override;
+    virtual void load(CheckpointReader&) override;
 
 };
 
 inline TargetedEvent::TargetedEvent(size_t size)
-    : _size(size), shrink_index(individual_index_t(size)) {}
+    : _size(size),
+      targeted_schedule(size, get_time()),
+      shrink_index(individual_index_t(size)),
+      target(individual_index_t(size)) {}
+
+inline EventBase* TargetedEvent::clone() const {
+    return new TargetedEvent(*this);
+}
+
+//' @title write the event's state, see Checkpoint.h
+//' @description the schedule is written as the individuals due on each
+//' timestep, in order of timestep
+inline void TargetedEvent::save(CheckpointWriter& out) const {
+    out.write_tag("TargetedEvent");
+    EventBase::save(out);
+    out.write(static_cast<uint64_t>(_size));
+    auto slots = std::map<size_t, const ScheduleSlot*>();
+    targeted_schedule.for_each([&](size_t timestep, const ScheduleSlot& slot) {
+        slots[timestep] = &slot;
+    });
+    out.write(static_cast<uint64_t>(slots.size()));
+    for (const auto& entry : slots) {
+        out.write(static_cast<uint64_t>(entry.first));
+        out.write(entry.second->to_bitset());
+    }
+    out.write(static_cast<uint64_t>(extensions.size()));
+    for (const auto& extension : extensions) {
+        out.write(static_cast<uint64_t>(extension.first));
+        out.write(extension.second);
+    }
+    out.write(shrink_index);
+    tombstones.save(out);
+}
+
+//' @title replace the event's state with one written by `save`
+//' @description the reverse index, if enabled, is rebuilt
+inline void TargetedEvent::load(CheckpointReader& in) {
+    in.expect_tag("TargetedEvent");
+    EventBase::load(in);
+    auto saved_size = uint64_t(0);
+    in.read(saved_size);
+    _size = saved_size;
+    targeted_schedule = TimingWheel(size(), get_time());
+    auto n_slots = uint64_t(0);
+    in.read(n_slots);
+    auto target = individual_index_t(0);
+    for (auto i = 0u; i < n_slots; ++i) {
+        auto timestep = uint64_t(0);
+        in.read(timestep);
+        in.read(target);
+        expect_consistent(
+            target.max_size() == size() && timestep >= get_time(),
+            "TargetedEvent"
+        );
+        targeted_schedule.at(timestep).insert(target);
+    }
+    extensions.resize(in.read_length(2 * sizeof(uint64_t)));
+    for (auto& extension : extensions) {
+        auto n = uint64_t(0);
+        in.read(n);
+        extension.first = n;
+        in.read(extension.second);
+        expect_consistent(
+            extension.second.empty() || extension.second.size() == n,
+            "TargetedEvent"
+        );
+    }
+    in.read(shrink_index);
+    tombstones.load(in);
+    expect_consistent(
+        shrink_index.max_size() == size() && tombstones.consistent(size()),
+        "TargetedEvent"
+    );
+    if (indexed) {
+        index.rebuild(targeted_schedule, size());
+    }
+}
 
 //' @title should first event fire on this timestep?
 inline bool TargetedEvent::should_trigger() {
-    if (targeted_schedule.begin() == targeted_schedule.end()) {
-        return false;
-    }
-    return targeted_schedule.begin()->first == get_time();
+    return targeted_schedule.find(get_time()) != nullptr;
 }
 
 //' @title process an event by calling a listener
@@ -173,14 +328,28 @@ inline void TargetedEvent::process(Rcpp::XPtr<targeted_listener_t> listener) {
     (*listener)(get_time(), current_target());
 }
 
-//' @title get bitset of individuals scheduled for the next event
+//' @title get bitset of individuals scheduled for the current timestep
+//' @description the bitset is made from the timing wheel on each call, so
+//' changing it does not change the schedule
 inline individual_index_t& TargetedEvent::current_target() {
-    return targeted_schedule.begin()->second;
+    const auto slot = targeted_schedule.find(get_time());
+    if (slot == nullptr) {
+        target = individual_index_t(size());
+    } else {
+        target = slot->to_bitset();
+    }
+    return target;
 }
 
-//' @title delete current time step from simple_schedule and increase time step
+//' @title delete current time step from targeted_schedule and increase time step
 inline void TargetedEvent::tick() {
-    targeted_schedule.erase(get_time());
+    if (indexed) {
+        const auto slot = targeted_schedule.find(get_time());
+        if (slot != nullptr) {
+            index.fire(get_time(), *slot);
+        }
+    }
+    targeted_schedule.advance();
     EventBase::tick();
 }
 
@@ -188,35 +357,29 @@ inline void TargetedEvent::tick() {
 //' @description Schedule each individual in `target_bitset` to fire an event
 //' at a corresponding `delay` timestep in the future.
 //' Delays may be continuous but our timeline is discrete, 
-//' so delays are rounded to the nearest timestep
+//' so delays are rounded to the nearest timestep.
+//' Each individual is put straight into the slot for their timestep, so
+//' this is a single pass over the target however many distinct delays there
+//' are.
 inline void TargetedEvent::schedule(
     const individual_index_t& target_bitset,
     const std::vector<double>& delay
 ) {
-    
-    //round the delays to find a discrete timestep to trigger each event
-    auto rounded = round_delay(delay);
-    
-    //get unique timesteps
-    auto delay_values = std::unordered_set<size_t>(
-        rounded.begin(),
-        rounded.end()
-    );
-    
-    // iterate through unique delay vals;
-    // for each delay go through target_bitset and delay and add to target
-    // for that delay if the delay matches the unique value
-    for (auto v : delay_values) {
-        auto target = individual_index_t(size());
-        auto bitset_it = target_bitset.cbegin();
-        for (auto i = 0u; i < rounded.size(); ++i) {
-            if (rounded[i] == v) {
-                target.insert(*bitset_it);
-            }
-            ++bitset_it;
-        }
-        schedule(target, v);
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::schedule(target_bitset, delay); });
+        return;
+    }
+    if (delay.size() != target_bitset.size()) {
+        Rcpp::stop("Mismatch between target and delay length");
     }
+    auto bitset_it = target_bitset.cbegin();
+    for_each_timestep(round_delay(delay), [&](ScheduleSlot& target, size_t timestep, size_t) {
+        target.insert(*bitset_it);
+        if (indexed) {
+            index.add(*bitset_it, timestep);
+        }
+        ++bitset_it;
+    });
 }
 
 //' @title schedule events
@@ -228,25 +391,54 @@ inline void TargetedEvent::schedule(
     const std::vector<size_t>& target_vector,
     const std::vector<double>& delay
 ) {
-    
-    //round the delays to find a discrete timestep to trigger each event
-    auto rounded = round_delay(delay);
-    
-    //get unique timesteps
-    auto delay_values = std::unordered_set<size_t>(
-        rounded.begin(),
-        rounded.end()
-    );
-    
-    for (auto v : delay_values) {
-        auto target = individual_index_t(size());
-        for (auto i = 0u; i < rounded.size(); ++i) {
-            if (rounded[i] == v) {
-                target.insert_safe(target_vector[i]);
-            }
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::schedule(target_vector, delay); });
+        return;
+    }
+    if (delay.size() != target_vector.size()) {
+        Rcpp::stop("Mismatch between target and delay length");
+    }
+    for (const auto& x : target_vector) {
+        if (x >= size()) {
+            Rcpp::stop("Insert out of range");
         }
-        schedule(target, v);
     }
+    for_each_timestep(round_delay(delay), [&](ScheduleSlot& target, size_t timestep, size_t i) {
+        target.insert(target_vector[i]);
+        if (indexed) {
+            index.add(target_vector[i], timestep);
+        }
+    });
+}
+
+//' @title visit the scheduled slot for each of a vector of delays
+//' @description the slot for the previous delay is reused when delays
+//' repeat, otherwise it is looked up (and created if necessary) once per
+//' individual. Delays are rounded before calling this so that invalid delays
+//' stop the schedule before anyone is scheduled.
+//' @param rounded the rounded delay for each individual
+//' @param f a function taking the slot for an individual's timestep, the
+//' timestep and the individual's position in `rounded`
+template<class F>
+inline void TargetedEvent::for_each_timestep(
+    const std::vector<size_t>& rounded,
+    F f
+) {
+    ScheduleSlot* target = nullptr;
+    auto last_delay = size_t(0);
+    for (auto i = 0u; i < rounded.size(); ++i) {
+        if (target == nullptr || rounded[i] != last_delay) {
+            target = &get_timestep(get_time() + rounded[i]);
+            last_delay = rounded[i];
+        }
+        f(*target, get_time() + rounded[i], i);
+    }
+}
+
+//' @title get the slot of individuals scheduled for a timestep, creating
+//' an empty one if there is none
+inline ScheduleSlot& TargetedEvent::get_timestep(size_t timestep) {
+    return targeted_schedule.at(timestep);
 }
 
 //' @title schedule events
@@ -266,58 +458,107 @@ inline void TargetedEvent::schedule(
     const individual_index_t& target,
     size_t delay
 ) {
-    
-    auto target_timestep = get_time() + delay;
-    if (targeted_schedule.find(target_timestep) == targeted_schedule.end()) {
-        targeted_schedule.insert(
-            {target_timestep, individual_index_t(size())}
-        );
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::schedule(target, delay); });
+        return;
+    }
+    const auto timestep = get_time() + delay;
+    get_timestep(timestep).insert(target);
+    if (indexed) {
+        for (auto i : target) {
+            index.add(i, timestep);
+        }
     }
-    targeted_schedule.at(target_timestep) |= target;
 }
 
 //' @title clear scheduled events for `target` individuals
+//' @description with the reverse index only the slots which the target are
+//' scheduled in are visited, otherwise the target is removed from every slot
 inline void TargetedEvent::clear_schedule(const individual_index_t& target) {
-    auto not_target = !target;
-    for (auto& entry : targeted_schedule) {
-        entry.second &= not_target;
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::clear_schedule(target); });
+        return;
+    }
+    if (indexed) {
+        clear_indexed(target);
+        return;
+    }
+    targeted_schedule.for_each([&](size_t, ScheduleSlot& slot) {
+        slot.erase(target);
+    });
+}
+
+//' @title clear scheduled events for `target` individuals
+inline void TargetedEvent::clear_schedule(const std::vector<size_t>& target) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::clear_schedule(target); });
+        return;
+    }
+    for (const auto& x : target) {
+        if (x >= size()) {
+            Rcpp::stop("Insert out of range");
+        }
+    }
+    if (indexed) {
+        auto sorted = target;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        clear_indexed(sorted);
+        return;
+    }
+    clear_schedule(individual_index_t(size(), target));
+}
+
+//' @title clear scheduled events with the reverse index
+//' @param target the individuals to clear, in ascending order
+template<class T>
+inline void TargetedEvent::clear_indexed(const T& target) {
+    auto cleared = std::map<size_t, std::vector<size_t>>();
+    for (auto i : target) {
+        for (auto timestep : index.remove(i)) {
+            cleared[timestep].push_back(i);
+        }
+    }
+    for (const auto& entry : cleared) {
+        targeted_schedule.at(entry.first).erase(entry.second);
     }
 }
 
 //' @title get all individuals scheduled for events
+//' @description with the reverse index this is a copy of the maintained
+//' union, otherwise every slot is visited
 inline individual_index_t TargetedEvent::get_scheduled() const {
-    auto scheduled = individual_index_t(size());
-    for (auto& entry : targeted_schedule) {
-        scheduled |= entry.second;
+    if (indexed) {
+        return index.get_scheduled();
     }
+    auto scheduled = individual_index_t(size());
+    targeted_schedule.for_each([&](size_t, const ScheduleSlot& slot) {
+        slot.add_to(scheduled);
+    });
     return scheduled;
 }
 
 inline void TargetedEvent::queue_extend(size_t n) {
-    extensions.push([&, n=n]() {
-        for (auto& entry : targeted_schedule) {
-            entry.second.extend(n);
-        }
-        _size += n;
-    });
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::queue_extend(n); });
+        return;
+    }
+    extensions.push_back({ n, std::vector<double>() });
 }
 
 inline void TargetedEvent::queue_extend(const std::vector<double>& delays) {
-    extensions.push([&, delays=delays]() {
-        for (auto& entry : targeted_schedule) {
-            entry.second.extend(delays.size());
-        }
-        auto target = std::vector<size_t>();
-        target.reserve(delays.size());
-        for (auto i = _size; i < _size + delays.size(); ++i) {
-            target.push_back(i);
-        }
-        _size += delays.size();
-        schedule(target, delays);
-    });
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::queue_extend(delays); });
+        return;
+    }
+    extensions.push_back({ delays.size(), delays });
 }
 
 inline void TargetedEvent::queue_shrink(const individual_index_t& index) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::queue_shrink(index); });
+        return;
+    }
     if (index.max_size() != size()) {
         Rcpp::stop("Invalid bitset size for variable shrink");
     }
@@ -325,6 +566,10 @@ inline void TargetedEvent::queue_shrink(const individual_index_t& index) {
 }
 
 inline void TargetedEvent::queue_shrink(const std::vector<size_t>& index) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->TargetedEvent::queue_shrink(index); });
+        return;
+    }
     for (const auto& x : index) {
         if (x >= size()) {
             Rcpp::stop("Invalid vector index for variable shrink");
@@ -337,30 +582,118 @@ inline size_t TargetedEvent::size() const {
     return _size;
 }
 
+//' @title apply the queued shrinks and extensions
+//' @description without tombstones, removed individuals are shrunk away and
+//' new individuals appended directly; a ResizePlan is only made when the
+//' tombstones allocate the slots
 inline void TargetedEvent::resize() {
-    auto size_changed = false;
-    // perform shrinks
-    if (shrink_index.size() > 0) {
-        const auto index = std::vector<size_t>(
-            shrink_index.begin(),
-            shrink_index.end()
-        );
-        for (auto& entry : targeted_schedule) {
-            entry.second.shrink(index);
+    if (shrink_index.size() == 0 && extensions.size() == 0) {
+        return;
+    }
+    if (tombstones.enabled()) {
+        apply_resize(ResizePlan(shrink_index, get_extend_size(), tombstones));
+        return;
+    }
+    const auto removed = std::vector<size_t>(shrink_index.cbegin(), shrink_index.cend());
+    const auto shrunk_size = size() - removed.size();
+    const auto new_size = shrunk_size + get_extend_size();
+    targeted_schedule.for_each([&](size_t, ScheduleSlot& slot) {
+        slot.resize(removed, new_size);
+    });
+    targeted_schedule.resize(new_size);
+    _size = new_size;
+    if (indexed) {
+        // the index is rebuilt with the new numbering below
+        index = ScheduleIndex(size());
+    }
+    auto first = shrunk_size;
+    for (const auto& extension : extensions) {
+        if (!extension.second.empty()) {
+            auto target = std::vector<size_t>(extension.first);
+            for (auto i = 0u; i < extension.first; ++i) {
+                target[i] = first + i;
+            }
+            schedule(target, extension.second);
         }
-        _size -= index.size();
-        size_changed = true;
+        first += extension.first;
     }
+    extensions.clear();
+    if (indexed) {
+        index.rebuild(targeted_schedule, size());
+    }
+    shrink_index = individual_index_t(size());
+}
 
-    while(extensions.size() > 0) {
-        const auto& update = extensions.front();
-        update();
-        extensions.pop();
-        size_changed = true;
+//' @title resize with a plan, the event's own queued shrinks are discarded
+inline void TargetedEvent::apply_resize(const ResizePlan& plan) {
+    if (!plan.empty()) {
+        // perform shrinks and extensions, then schedule new individuals in
+        // the order they were queued
+        targeted_schedule.for_each([&](size_t, ScheduleSlot& slot) {
+            slot.allocate(plan);
+        });
+        targeted_schedule.resize(plan.allocated_size);
+        _size = plan.allocated_size;
+        if (indexed) {
+            // the index is rebuilt with the new numbering below
+            index = ScheduleIndex(size());
+        }
+        auto first = plan.slots.cbegin();
+        for (const auto& extension : extensions) {
+            const auto last = first + extension.first;
+            if (!extension.second.empty()) {
+                schedule(std::vector<size_t>(first, last), extension.second);
+            }
+            first = last;
+        }
+        extensions.clear();
+
+        targeted_schedule.for_each([&](size_t, ScheduleSlot& slot) {
+            slot.compact(plan);
+        });
+        targeted_schedule.resize(plan.final_size());
+        _size = plan.final_size();
+        if (indexed) {
+            index.rebuild(targeted_schedule, size());
+        }
+        if (plan.tombstones != nullptr && plan.tombstones != &tombstones) {
+            tombstones = *plan.tombstones;
+        }
+    }
+    shrink_index = individual_index_t(size());
+}
+
+//' @title the number of new individuals queued
+inline size_t TargetedEvent::get_extend_size() const {
+    auto n = size_t(0);
+    for (const auto& extension : extensions) {
+        n += extension.first;
     }
+    return n;
+}
+
+//' @title the number of individuals queued for removal
+inline size_t TargetedEvent::get_shrink_size() const {
+    return shrink_index.size();
+}
+
+//' @title keep removed individuals' slots free rather than compacting them
+//' on every resize, see Tombstones
+inline void TargetedEvent::enable_tombstones(const double threshold) {
+    tombstones.enable(threshold, size());
+}
+
+inline const Tombstones& TargetedEvent::get_tombstones() const {
+    return tombstones;
+}
 
-    if (size_changed) {
-        shrink_index = individual_index_t(size());
+//' @title keep the timesteps each individual is scheduled for, so that
+//' clearing k individuals visits only their slots and the scheduled
+//' individuals are kept up to date rather than gathered from every slot
+inline void TargetedEvent::enable_reverse_index() {
+    if (!indexed) {
+        index.rebuild(targeted_schedule, size());
+        indexed = true;
     }
 }
 
@@ -23,6 +23,7 @@ struct IntegerVariable;
 struct IntegerVariable : public NumericVariable<int> {
     IntegerVariable(const std::vector<int>& values);
     virtual ~IntegerVariable() = default;
+    virtual Variable* clone() const override;
     virtual individual_index_t get_index_of_set(const std::vector<int>&) const;
     virtual individual_index_t get_index_of_set(const int) const;
     virtual individual_index_t get_index_of_range(const int, const int) const;
@@ -35,83 +36,50 @@ struct IntegerVariable : public NumericVariable<int> {
 inline IntegerVariable::IntegerVariable(const std::vector<int>& values)
     : NumericVariable<int>(values) {}
 
+inline Variable* IntegerVariable::clone() const {
+    return new IntegerVariable(*this);
+}
+
 //' @title return bitset giving index of individuals whose value is in a finite set
 inline individual_index_t IntegerVariable::get_index_of_set(
     const std::vector<int>& values_set
 ) const {
-    
-    auto result = individual_index_t(size());
-    for (auto i = 0u; i < size(); ++i) {
-        auto findit = std::find(values_set.begin(), values_set.end(), values[i]);
-        if(findit != values_set.end()){
-            result.insert(i);
-        }
-    }
-    
-    return result;
+    return vector_index_where(values.read(), tombstones, in_set<int>{ values_set });
 }
 
 //' @title return bitset giving index of individuals whose value is equal to a specific scalar
 inline individual_index_t IntegerVariable::get_index_of_set(
     const int value
 ) const {
-    
-    auto result = individual_index_t(size());
-    for (auto i = 0u; i < values.size(); ++i) {
-        if ( values[i] == value ) {
-            result.insert(i);
-        }
-    }
-    
-    return result;
+    return vector_index_where(values.read(), tombstones, equal_to_value<int>{ value });
 }
 
 //' @title return bitset giving index of individuals whose value is in some range [a,b]
 inline individual_index_t IntegerVariable::get_index_of_range(
         const int a, const int b
 ) const {
-    
-    auto result = individual_index_t(size());
-    for (auto i = 0u; i < values.size(); ++i) {
-        if ( !(values[i] < a) && !(b < values[i]) ) {
-            result.insert(i);
-        }
-    }
-    
-    return result;
+    return vector_index_where(values.read(), tombstones, in_range<int>{ a, b });
 }
 
 //' @title return number of individuals whose value is in a finite set
 inline size_t IntegerVariable::get_size_of_set(
         const std::vector<int>& values_set
 ) const {
-    
-    size_t result = std::count_if(values.begin(), values.end(), [&](const int v) -> bool {
-        auto findit = std::find(values_set.begin(), values_set.end(), v);
-        return findit != values_set.end();
-    });
-    
-    return result;
+    return vector_count_where(values.read(), tombstones, in_set<int>{ values_set });
 }
 
 //' @title return number of individuals whose value is equal to a specific scalar
 inline size_t IntegerVariable::get_size_of_set(
         const int value
 ) const {
-    
-    size_t result = std::count(values.begin(), values.end(), value);
-    return result;
+    return vector_count_where(values.read(), tombstones, equal_to_value<int>{ value });
 }
 
 //' @title return number of individuals whose value is in some range [a,b]
 inline size_t IntegerVariable::get_size_of_range(
         const int a, const int b
 ) const {
-    size_t result = std::count_if(values.begin(), values.end(), [&](const int v) -> bool {
-        return !(v < a) && !(b < v);
-    });
-    
-    return result;
+    return vector_count_where(values.read(), tombstones, in_range<int>{ a, b });
 }
 
 #endif /* INST_INCLUDE_INTEGER_VARIABLE_H_ */
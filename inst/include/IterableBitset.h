@@ -11,10 +11,22 @@
 #include <cmath>
 #include <Rcpp.h>
 #include "utils.h"
+#include "CopyOnWrite.h"
+#include "ParallelPolicy.h"
+#include "Random.h"
 
 template<class A>
 class IterableBitset;
 
+//' @title the number of times bitset storage has been allocated on this thread
+//' @description counts new bitsets and the copies made when a bitset changes
+//' storage which it shares, see CopyOnWrite.h. Profiler.h reports the change
+//' in this count over each phase of the simulation loop.
+inline size_t& bitset_allocations() {
+    static thread_local size_t count = 0;
+    return count;
+}
+
 //' @title A bitset you can iterate with
 //' @description This is a bitset, a data structure for sets of unsigned integers.
 //' Insertion and erasure are fast.
@@ -22,6 +34,7 @@ class IterableBitset;
 //'
 //' Under the hood, we use a vector of integers.
 //' Each integer stores the existance of sizeof(A) * 8 elements in the set.
+//' Copies share the vector until one of them changes, see CopyOnWrite.h.
 template<class A>
 class IterableBitset {
     size_t max_n;
@@ -30,7 +43,8 @@ class IterableBitset {
     bool exists(size_t) const;
     void set(size_t);
     void unset(size_t);
-    std::vector<A> bitmap;
+    std::vector<A>& words_to_change();
+    CopyOnWrite<std::vector<A>> bitmap;
 public:
     using allocator_type = std::allocator<size_t>;
     using value_type = allocator_type::value_type;
@@ -79,6 +93,8 @@ public:
     IterableBitset& operator^=(const IterableBitset&);
     IterableBitset& clear();
     IterableBitset& inverse();
+    template<class F>
+    IterableBitset& assign_words(F);
     iterator begin();
     const_iterator begin() const;
     const_iterator cbegin() const;
@@ -96,8 +112,11 @@ public:
     size_type size() const;
     size_type max_size() const;
     bool empty() const;
+    bool intersects(const IterableBitset&) const;
     void extend(size_t);
     void shrink(const std::vector<size_t>&);
+    void reset(size_t);
+    const std::vector<A>& words() const;
 };
 
 
@@ -159,7 +178,7 @@ inline IterableBitset<A>::const_iterator::const_iterator(
 template<class A>
 inline IterableBitset<A>::const_iterator::const_iterator(
     const IterableBitset& index) : index(index), p(static_cast<size_t>(-1)) {
-    p = next_position(index.bitmap, index.num_bits, index.max_n, p);
+    p = next_position(index.bitmap.read(), index.num_bits, index.max_n, p);
 }
 
 template<class A>
@@ -176,7 +195,7 @@ inline bool IterableBitset<A>::const_iterator::operator !=(
 
 template<class A>
 inline typename IterableBitset<A>::const_iterator& IterableBitset<A>::const_iterator::operator ++() {
-    p = next_position(index.bitmap, index.num_bits, index.max_n, p);
+    p = next_position(index.bitmap.read(), index.num_bits, index.max_n, p);
     return *this;
 }
 
@@ -189,6 +208,7 @@ template<class A>
 inline IterableBitset<A>::IterableBitset(size_t size) : max_n(size){
     num_bits = sizeof(A) * 8;
     bitmap = std::vector<A>(size/num_bits + 1, 0);
+    ++bitset_allocations();
     n = 0;
 }
 
@@ -212,7 +232,7 @@ inline IterableBitset<A>::IterableBitset(
 
 template<class A>
 inline bool IterableBitset<A>::operator ==(const IterableBitset<A>& other) const {
-    return bitmap == other.bitmap;
+    return bitmap.read() == other.bitmap.read();
 }
 
 template<class A>
@@ -237,8 +257,12 @@ inline IterableBitset<A> IterableBitset<A>::operator ^(const IterableBitset<A>&
 
 template<class A>
 inline IterableBitset<A>& IterableBitset<A>::clear() {
-  for (auto i = 0u; i < bitmap.size(); ++i) {
-    bitmap[i] = 0x0ULL;
+  if (bitmap.shared()) {
+    bitmap = std::vector<A>(bitmap.read().size(), 0);
+    ++bitset_allocations();
+  } else {
+    auto& words = bitmap.write();
+    std::fill(words.begin(), words.end(), 0x0ULL);
   }
   n = 0;
   return *this;
@@ -246,14 +270,43 @@ inline IterableBitset<A>& IterableBitset<A>::clear() {
 
 template<class A>
 inline IterableBitset<A>& IterableBitset<A>::inverse() {
-  for (auto i = 0u; i < bitmap.size(); ++i) {
-    bitmap[i] = ~bitmap[i];
-  }
   //mask out the values after max_n
-  A residual = (static_cast<A>(1) << (max_n % num_bits)) - 1;
-  bitmap[bitmap.size() - 1] &= residual;
-  n = max_n - n;
-  return *this;
+  const A residual = (static_cast<A>(1) << (max_n % num_bits)) - 1;
+  const auto& words = bitmap.read();
+  const auto last = words.size() - 1;
+  return assign_words([&](size_t i) -> A {
+    if (i == last) {
+      return ~words[i] & residual;
+    }
+    return ~words[i];
+  });
+}
+
+//' @title set every word of the bitset
+//' @description sets word i to `f(i)` for each i and recounts the set. Large
+//' bitsets are split into chunks of words which are set in parallel, see
+//' ParallelPolicy.h, so `f` may read any other bitset but only word i of this
+//' one. `f` must not set bits past max_size. If the words are shared with a
+//' copy, they are set in new storage rather than copied first.
+template<class A>
+template<class F>
+inline IterableBitset<A>& IterableBitset<A>::assign_words(F f) {
+    const auto shared = bitmap.shared();
+    auto fresh = std::vector<A>(shared ? bitmap.read().size() : 0);
+    auto& words = shared ? fresh : bitmap.write();
+    n = parallel_for_words(words.size(), [&](size_t begin, size_t end) {
+        auto count = size_t(0);
+        for (auto i = begin; i < end; ++i) {
+            words[i] = f(i);
+            count += popcount(words[i]);
+        }
+        return count;
+    });
+    if (shared) {
+        bitmap = std::move(fresh);
+        ++bitset_allocations();
+    }
+    return *this;
 }
 
 template<class A>
@@ -268,12 +321,9 @@ inline IterableBitset<A>& IterableBitset<A>::operator &=(const IterableBitset<A>
     if (max_size() != other.max_size()) {
         Rcpp::stop("Incompatible bitmap sizes");
     }
-    n = 0;
-    for (auto i = 0u; i < bitmap.size(); ++i) {
-        bitmap[i] &= other.bitmap[i];
-        n += popcount(bitmap[i]);
-    }
-    return *this;
+    const auto& words = bitmap.read();
+    const auto& other_words = other.bitmap.read();
+    return assign_words([&](size_t i) { return words[i] & other_words[i]; });
 }
 
 template<class A>
@@ -281,12 +331,9 @@ inline IterableBitset<A>& IterableBitset<A>::operator |=(const IterableBitset<A>
     if (max_size() != other.max_size()) {
         Rcpp::stop("Incompatible bitmap sizes");
     }
-    n = 0;
-    for (auto i = 0u; i < bitmap.size(); ++i) {
-        bitmap[i] |= other.bitmap[i];
-        n += popcount(bitmap[i]);
-    }
-    return *this;
+    const auto& words = bitmap.read();
+    const auto& other_words = other.bitmap.read();
+    return assign_words([&](size_t i) { return words[i] | other_words[i]; });
 }
 
 template<class A>
@@ -294,12 +341,9 @@ inline IterableBitset<A>& IterableBitset<A>::operator ^=(const IterableBitset<A>
     if (max_size() != other.max_size()) {
         Rcpp::stop("Incompatible bitmap sizes");
     }
-    n = 0;
-    for (auto i = 0u; i < bitmap.size(); ++i) {
-        bitmap[i] ^= other.bitmap[i];
-        n += popcount(bitmap[i]);
-    }
-    return *this;
+    const auto& words = bitmap.read();
+    const auto& other_words = other.bitmap.read();
+    return assign_words([&](size_t i) { return words[i] ^ other_words[i]; });
 }
 
 template<class A>
@@ -336,17 +380,27 @@ inline typename IterableBitset<A>::const_iterator IterableBitset<A>::cend() cons
 //' @description check if the bit at position `v` is set
 template<class A>
 inline bool IterableBitset<A>::exists(size_t v) const {
-    return (bitmap.at(v/num_bits) & (0x1ULL << (v % num_bits))) > 0;
+    return (bitmap.read().at(v/num_bits) & (0x1ULL << (v % num_bits))) > 0;
 }
 
 template<class A>
 inline void IterableBitset<A>::set(size_t v) {
-    bitmap[v/num_bits] |= (0x1ULL << (v % num_bits));
+    words_to_change()[v/num_bits] |= (0x1ULL << (v % num_bits));
 }
 
 template<class A>
 inline void IterableBitset<A>::unset(size_t v) {
-    bitmap[v/num_bits] &= ~(0x1ULL << (v % num_bits));
+    words_to_change()[v/num_bits] &= ~(0x1ULL << (v % num_bits));
+}
+
+//' @title the words, ready to be changed
+//' @description counts the copy made if the words are shared
+template<class A>
+inline std::vector<A>& IterableBitset<A>::words_to_change() {
+    if (bitmap.shared()) {
+        ++bitset_allocations();
+    }
+    return bitmap.write();
 }
 
 template<class A>
@@ -431,6 +485,24 @@ inline bool IterableBitset<A>::empty() const {
     return n == 0;
 }
 
+//' @title check whether any element is in both bitsets
+//' @description stops at the first word the bitsets have in common, so it is
+//' cheaper than an intersection, and does not copy words shared with a copy
+template<class A>
+inline bool IterableBitset<A>::intersects(const IterableBitset<A>& other) const {
+    if (max_size() != other.max_size()) {
+        Rcpp::stop("Incompatible bitmap sizes");
+    }
+    const auto& words = bitmap.read();
+    const auto& other_words = other.bitmap.read();
+    for (auto i = 0u; i < words.size(); ++i) {
+        if ((words[i] & other_words[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 //' @title bitset to vector
 //' @description return a vector of unsigned ints indicating which bits are set
 template<class A>
@@ -480,15 +552,8 @@ inline void bitset_choose_internal(
     IterableBitset<A>& b,
     const size_t k
 ){
-  auto to_remove = Rcpp::sample(
-    b.size(),
-    b.size() - k,
-    false, // replacement
-    R_NilValue, // evenly distributed
-    false // one based
-  );
-  std::sort(to_remove.begin(), to_remove.end());
-  auto bitset_i = 0;
+  const auto to_remove = random_sample(b.size(), b.size() - k);
+  auto bitset_i = size_t(0);
   auto bitset_it = b.cbegin();
   for (auto i : to_remove) {
     while(bitset_i != i) {
@@ -510,15 +575,11 @@ inline void bitset_sample_internal(
     IterableBitset<A>& b,
     const double rate
 ){
-    auto to_remove = Rcpp::sample(
+    const auto to_remove = random_sample(
         b.size(),
-        Rcpp::rbinom(1, b.size(), 1 - std::min(rate, 1.))[0],
-        false, // replacement
-        R_NilValue, // evenly distributed
-        false // one based
+        random_binomial(b.size(), 1 - std::min(rate, 1.))
     );
-    std::sort(to_remove.begin(), to_remove.end());
-    auto bitset_i = 0;
+    auto bitset_i = size_t(0);
     auto bitset_it = b.cbegin();
     for (auto i : to_remove) {
       while(bitset_i != i) {
@@ -544,7 +605,7 @@ inline void bitset_sample_multi_internal(
 ){  
     // sample elements
     size_t n = b.size();
-    const auto random = Rcpp::runif(n);
+    const auto random = random_uniform(n);
     auto i = 0u;
     auto probs_it = begin;
     auto bitset_it = b.cbegin();
@@ -564,10 +625,11 @@ inline void bitset_sample_multi_internal(
 template<class A>
 inline void IterableBitset<A>::extend(size_t n) {  
     const auto n_blocks = (max_n + n) / num_bits + 1;
-    if (n_blocks > bitmap.size()) {
-        bitmap.insert(
-            bitmap.end(),
-            n_blocks - bitmap.size(),
+    if (n_blocks > bitmap.read().size()) {
+        auto& words = words_to_change();
+        words.insert(
+            words.end(),
+            n_blocks - words.size(),
             static_cast<A>(0)
         );
     }
@@ -599,13 +661,42 @@ inline void IterableBitset<A>::shrink(const std::vector<size_t>& index) {
         }
     }
     auto max_block = (max_n - index.size()) / num_bits + 1;
-    if (max_block < bitmap.size()) {
-        bitmap.erase(bitmap.begin() + max_block, bitmap.end());
+    if (max_block < bitmap.read().size()) {
+        if (bitmap.shared()) {
+            bitmap = std::vector<A>(max_block, 0);
+            ++bitset_allocations();
+        } else {
+            auto& words = bitmap.write();
+            words.erase(words.begin() + max_block, words.end());
+        }
     }
     clear();
     insert(values.cbegin(), values.cend());
     max_n -= index.size();
 }
 
+//' @title reset the bitset
+//' @description empties the bitset and changes its maximum size, reusing the
+//' existing memory where possible
+template<class A>
+inline void IterableBitset<A>::reset(size_t size) {
+    if (bitmap.shared()) {
+        bitmap = std::vector<A>(size / num_bits + 1, 0);
+        ++bitset_allocations();
+    } else {
+        bitmap.write().resize(size / num_bits + 1);
+    }
+    max_n = size;
+    clear();
+}
+
+//' @title the words of the bitset
+//' @description for algorithms which process the set one word at a time. Bit
+//' i of word j represents the element j * sizeof(A) * 8 + i
+template<class A>
+inline const std::vector<A>& IterableBitset<A>::words() const {
+    return bitmap.read();
+}
+
 #endif /* INST_INCLUDE_ITERABLEBITSET_H_ */
 
@@ -0,0 +1,58 @@
+/*
+ * NameTable.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_NAME_TABLE_H_
+#define INST_INCLUDE_NAME_TABLE_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//' @title names for the processes and structures of a simulation
+//' @description Used by Profiler and Tracer to label what they measure.
+//' Processes are named by their position and structures by their address,
+//' so that names only need to be given once, before the simulation runs.
+//' It contains the following data members:
+//'     * process_names: the name of each process, in order
+//'     * structure_names: the name of each variable, event and population
+class NameTable {
+    std::vector<std::string> process_names;
+    std::unordered_map<const void*, std::string> structure_names;
+
+public:
+    virtual ~NameTable() = default;
+
+    virtual void name_processes(const std::vector<std::string>&);
+    virtual void name_structure(const void*, const std::string&);
+    virtual std::string process_name(size_t) const;
+    virtual std::string structure_name(const void*) const;
+};
+
+inline void NameTable::name_processes(const std::vector<std::string>& names) {
+    process_names = names;
+}
+
+inline void NameTable::name_structure(const void* structure, const std::string& name) {
+    structure_names[structure] = name;
+}
+
+//' @title the name of the i-th process, counted from zero
+inline std::string NameTable::process_name(size_t i) const {
+    if (i < process_names.size()) {
+        return process_names[i];
+    }
+    return "process " + std::to_string(i + 1);
+}
+
+inline std::string NameTable::structure_name(const void* structure) const {
+    const auto it = structure_names.find(structure);
+    if (it == structure_names.end()) {
+        return "unnamed";
+    }
+    return it->second;
+}
+
+#endif /* INST_INCLUDE_NAME_TABLE_H_ */
@@ -11,6 +11,8 @@
 #include "Variable.h"
 #include "common_types.h"
 #include "vector_variables.h"
+#include "ValuesView.h"
+#include "CopyOnWrite.h"
 #include <Rcpp.h>
 #include <queue>
 
@@ -23,17 +25,23 @@ class NumericVariable;
 //' It contains the following data members:
 //'     * updates: a priority queue of pairs of values and indices to update
 //'     * size: the number of elements stored (size of population)
-//'     * values: a vector of values
+//'     * values: a vector of values, shared with copies of the variable until
+//'     either changes, see CopyOnWrite.h
+//'     * views: read-only views of values which are detached before updates
+//'     * version: incremented each time the values change
 template <class A>
 class NumericVariable : public Variable {
 
+protected:
     using update_t = std::pair<std::vector<A>, std::vector<size_t>>;
     std::queue<update_t> updates;
     individual_index_t shrink_index;
     std::vector<A> extend_values;
-
-protected:
-    std::vector<A> values;
+    CopyOnWrite<std::vector<A>> values;
+    mutable ViewRegistry<A> views;
+    size_t version = 0;
+    virtual void save_values(CheckpointWriter&) const;
+    virtual void load_values(CheckpointReader&);
     
 public:
     NumericVariable(const std::vector<A>& values);
@@ -42,6 +50,8 @@ public:
     virtual std::vector<A> get_values() const;
     virtual std::vector<A> get_values(const individual_index_t& index) const;
     virtual std::vector<A> get_values(const std::vector<size_t>& index) const;
+    virtual std::shared_ptr<ValuesView<A>> get_values_view() const;
+    virtual size_t get_version() const;
 
     virtual individual_index_t get_index_of_range(const A a, const A b) const;
     virtual size_t get_size_of_range(const A a, const A b) const;
@@ -51,7 +61,14 @@ public:
     virtual void queue_shrink(const std::vector<size_t>&);
     virtual void queue_shrink(const individual_index_t&);
     virtual void resize() override;
+    virtual void apply_resize(const ResizePlan&) override;
+    virtual size_t get_extend_size() const override;
+    virtual size_t get_shrink_size() const override;
+    virtual size_t get_queue_size() const override;
     virtual size_t size() const override;
+    virtual Variable* clone() const override;
+    virtual void save(CheckpointWriter&) const override;
+    virtual void load(CheckpointReader&) override;
 
     virtual void update() override;
 };
@@ -64,39 +81,35 @@ inline NumericVariable<A>::NumericVariable(const std::vector<A>& values)
 //' @title get all values
 template<class A>
 inline std::vector<A> NumericVariable<A>::get_values() const {
-    return values;
+    return values.read();
+}
+
+//' @title get a read-only view of all values
+//' @description the view is not affected by subsequent updates or resizes
+template<class A>
+inline std::shared_ptr<ValuesView<A>> NumericVariable<A>::get_values_view() const {
+    auto view = std::make_shared<VectorView<A>>(values.read());
+    views.add(view);
+    return view;
+}
+
+//' @title get a number which changes whenever the values change
+//' @description lets callers cache results which are derived from the values
+template<class A>
+inline size_t NumericVariable<A>::get_version() const {
+    return version;
 }
 
 //' @title get values at index given by a bitset
 template<class A>
 inline std::vector<A> NumericVariable<A>::get_values(const individual_index_t& index) const {
-    if (size() != index.max_size()) {
-        Rcpp::stop("incompatible size bitset used to get values from NumericVariable");
-    }
-    auto result = std::vector<A>(index.size());
-    auto result_i = 0u;
-    for (auto i : index) {
-        result[result_i] = values[i];
-        ++result_i;
-    }
-    return result;
+    return vector_get_values<A>(values.read(), index);
 }
 
 //' @title get values at index given by a vector
 template<class A>
 inline std::vector<A> NumericVariable<A>::get_values(const std::vector<size_t>& index) const {
-    
-    auto result = std::vector<A>(index.size());
-    for (auto i = 0u; i < index.size(); ++i) {
-        if (index[i] >= size()) {
-            std::stringstream message;
-            message << "index for NumericVariable out of range, supplied index: ";
-            message << index[i] << ", size of variable: " << size();
-            Rcpp::stop(message.str()); 
-        }
-        result[i] = values[index[i]];
-    }
-    return result;
+    return vector_get_values<A>(values.read(), index);
 }
 
 //' @title return bitset giving index of individuals whose value is in some range [a,b]
@@ -104,16 +117,7 @@ template<class A>
 inline individual_index_t NumericVariable<A>::get_index_of_range(
         const A a, const A b
 ) const {
-    
-    auto result = individual_index_t(size());
-    for (auto i = 0u; i < size(); ++i) {
-        if( !(values[i] < a) && !(b < values[i]) ) {
-            result.insert(i);
-        }
-    }
-    
-    return result;
-    
+    return vector_index_where(values.read(), tombstones, in_range<A>{ a, b });
 }
 
 //' @title return number of individuals whose value is in some range [a,b]
@@ -121,13 +125,7 @@ template<class A>
 inline size_t NumericVariable<A>::get_size_of_range(
         const A a, const A b
 ) const {
-    
-    size_t result = std::count_if(values.begin(), values.end(), [&](const A v) -> bool {
-        return !(v < a) && !(b < v);
-    });
-    
-    return result;
-    
+    return vector_count_where(values.read(), tombstones, in_range<A>{ a, b });
 }
 
 //' @title queue a state update for some subset of individuals
@@ -136,6 +134,10 @@ inline void NumericVariable<A>::queue_update(
         const std::vector<A>& values,
         const std::vector<size_t>& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->NumericVariable<A>::queue_update(values, index); });
+        return;
+    }
     if (values.empty()) {
         return;
     }
@@ -154,7 +156,11 @@ inline void NumericVariable<A>::queue_update(
 //' @title apply all queued state updates in FIFO order
 template<class A>
 inline void NumericVariable<A>::update() {
-    vector_update(updates, values);
+    if (updates.size() > 0) {
+        views.detach();
+        ++version;
+        vector_update(updates, values.write());
+    }
 }
 
 //' @title queue new values to add to the variable
@@ -162,6 +168,10 @@ template<class A>
 inline void NumericVariable<A>::queue_extend(
     const std::vector<A>& new_values
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->NumericVariable<A>::queue_extend(new_values); });
+        return;
+    }
     extend_values.insert(
         extend_values.cend(),
         new_values.cbegin(),
@@ -174,6 +184,10 @@ template<class A>
 inline void NumericVariable<A>::queue_shrink(
     const individual_index_t& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->NumericVariable<A>::queue_shrink(index); });
+        return;
+    }
     if (index.max_size() != size()) {
         Rcpp::stop("Invalid bitset size for variable shrink");
     }
@@ -185,6 +199,10 @@ template<class A>
 inline void NumericVariable<A>::queue_shrink(
     const std::vector<size_t>& index
 ) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->NumericVariable<A>::queue_shrink(index); });
+        return;
+    }
     for (const auto& x : index) {
         if (x >= size()) {
             Rcpp::stop("Invalid vector index for variable shrink");
@@ -193,14 +211,117 @@ inline void NumericVariable<A>::queue_shrink(
     shrink_index.insert(index.cbegin(), index.cend());
 }
 
+//' @title apply the queued shrinks and extensions
+//' @description without tombstones, the values are resized in place; a
+//' ResizePlan is only made when the tombstones allocate the slots
 template<class A>
 inline void NumericVariable<A>::resize() {
-    resize_vector(values, shrink_index, extend_values);
+    if (shrink_index.size() == 0 && extend_values.size() == 0) {
+        return;
+    }
+    if (tombstones.enabled()) {
+        apply_resize(ResizePlan(shrink_index, extend_values.size(), tombstones));
+        return;
+    }
+    views.detach();
+    ++version;
+    resize_vector(values.write(), shrink_index, extend_values);
+    shrink_index.reset(size());
+}
+
+//' @title resize with a plan, the variable's own queued shrinks are discarded
+template<class A>
+inline void NumericVariable<A>::apply_resize(const ResizePlan& plan) {
+    if (!plan.empty()) {
+        views.detach();
+        ++version;
+        resize_vector(values.write(), plan, extend_values);
+        follow_tombstones(plan);
+    }
+    shrink_index.reset(size());
+}
+
+template<class A>
+inline size_t NumericVariable<A>::get_extend_size() const {
+    return extend_values.size();
+}
+
+template<class A>
+inline size_t NumericVariable<A>::get_shrink_size() const {
+    return shrink_index.size();
+}
+
+template<class A>
+inline size_t NumericVariable<A>::get_queue_size() const {
+    return updates.size();
 }
 
 template<class A>
 inline size_t NumericVariable<A>::size() const {
-    return values.size();
+    return values.read().size();
+}
+
+template<class A>
+inline Variable* NumericVariable<A>::clone() const {
+    return new NumericVariable<A>(*this);
+}
+
+//' @title write the variable's state, see Checkpoint.h
+template<class A>
+inline void NumericVariable<A>::save(CheckpointWriter& out) const {
+    out.write_tag("NumericVariable");
+    out.write_type<A>();
+    save_values(out);
+    write_queue(out, updates, [&](const update_t& update) {
+        out.write(update.first);
+        out.write(update.second);
+    });
+    out.write(shrink_index);
+    out.write(extend_values);
+    tombstones.save(out);
+}
+
+//' @title replace the variable's state with one written by `save`
+template<class A>
+inline void NumericVariable<A>::load(CheckpointReader& in) {
+    in.expect_tag("NumericVariable");
+    in.expect_type<A>();
+    views.detach();
+    ++version;
+    load_values(in);
+    read_queue(in, updates, [&]() {
+        auto update = update_t();
+        in.read(update.first);
+        in.read(update.second);
+        expect_consistent(
+            queued_update_fits(update.first.size(), update.second, size()),
+            "NumericVariable"
+        );
+        return update;
+    });
+    in.read(shrink_index);
+    in.read(extend_values);
+    tombstones.load(in);
+    expect_consistent(
+        shrink_index.max_size() == size() && tombstones.consistent(size()),
+        "NumericVariable"
+    );
+}
+
+//' @title write the values with their storage type, which variables with
+//' other storage override
+template<class A>
+inline void NumericVariable<A>::save_values(CheckpointWriter& out) const {
+    out.write_type<A>();
+    out.write(values.read());
+}
+
+template<class A>
+inline void NumericVariable<A>::load_values(CheckpointReader& in) {
+    in.expect_type<A>();
+    auto loaded = std::vector<A>();
+    in.read(loaded);
+    values = std::move(loaded);
 }
 
 #endif /* INST_INCLUDE_NUMERIC_VARIABLE_H_ */
@@ -0,0 +1,100 @@
+/*
+ * ParallelPolicy.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_PARALLEL_POLICY_H_
+#define INST_INCLUDE_PARALLEL_POLICY_H_
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//' @title how to run single large operations, such as bitset operations and
+//' variable scans
+//' @description Operations over at least `threshold` individuals are split
+//' into one chunk of whole 64 bit words per thread and run on a shared pool,
+//' so no two threads ever write to the same word of a bitset. Smaller
+//' operations, and operations started inside a task on another pool, run on
+//' the calling thread.
+//' It contains the following data members:
+//'     * threads: the number of threads, including the calling thread, which
+//'     may be read without taking busy
+//'     * threshold: the smallest number of individuals to split, which may be
+//'     read without taking busy
+//'     * pool: the pool to run on, or nullptr for one thread
+//'     * busy: held while the pool is running an operation
+struct ParallelPolicy {
+    std::atomic<size_t> threads{1};
+    std::atomic<size_t> threshold{1000000};
+    std::unique_ptr<ThreadPool> pool;
+    std::mutex busy;
+};
+
+inline ParallelPolicy& parallel_policy() {
+    static ParallelPolicy policy;
+    return policy;
+}
+
+//' @title change the number of threads and threshold for large operations
+inline void set_parallel_policy(size_t threads, size_t threshold) {
+    auto& policy = parallel_policy();
+    std::lock_guard<std::mutex> guard(policy.busy);
+    threads = std::max(threads, size_t(1));
+    if (threads != policy.threads) {
+        policy.pool.reset(threads > 1 ? new ThreadPool(threads) : nullptr);
+        policy.threads = threads;
+    }
+    policy.threshold = std::max(threshold, size_t(1));
+}
+
+//' @title run a function over chunks of 64 bit words and sum the results
+//' @description `f(begin, end)` is called for consecutive chunks of the word
+//' indices [0, n_words), in parallel if the parallel policy allows it. Each
+//' chunk may only write to its own words, or to the individuals those words
+//' hold.
+//' @param n_words the number of words
+//' @param f a function of the first and one past the last word of a chunk,
+//' returning a count
+//' @return the sum of the counts for each chunk
+template<class F>
+inline size_t parallel_for_words(size_t n_words, F f) {
+    if (in_pool_task()) {
+        return f(size_t(0), n_words);
+    }
+    auto& policy = parallel_policy();
+    // operations which will not be split never take the lock
+    if (policy.threads == 1 || n_words * 64 < policy.threshold) {
+        return f(size_t(0), n_words);
+    }
+    std::unique_lock<std::mutex> guard(policy.busy, std::try_to_lock);
+    // the pool may be in use by another thread, or removed since threads
+    // was read
+    if (!guard.owns_lock() || policy.pool == nullptr) {
+        if (guard.owns_lock()) {
+            guard.unlock();
+        }
+        return f(size_t(0), n_words);
+    }
+    const auto n_chunks = std::min(policy.pool->size(), n_words);
+    auto counts = std::vector<size_t>(n_chunks, 0);
+    auto tasks = std::vector<std::function<void ()>>();
+    for (auto c = 0u; c < n_chunks; ++c) {
+        const auto begin = n_words * c / n_chunks;
+        const auto end = n_words * (c + 1) / n_chunks;
+        auto& count = counts[c];
+        tasks.push_back([&f, &count, begin, end]() { count = f(begin, end); });
+    }
+    policy.pool->run(tasks);
+    auto total = size_t(0);
+    for (auto count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+#endif /* INST_INCLUDE_PARALLEL_POLICY_H_ */
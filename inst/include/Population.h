@@ -0,0 +1,208 @@
+/*
+ * Population.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_POPULATION_H_
+#define INST_INCLUDE_POPULATION_H_
+
+#include "Variable.h"
+#include "Event.h"
+#include "ResizePlan.h"
+#include "Staging.h"
+#include "ThreadPool.h"
+#include <Rcpp.h>
+
+//' @title resize a set of variables and events together
+//' @description Instead of each structure working out which individuals to
+//' remove and where to put new ones, the population makes one plan for the
+//' timestep and applies it to every structure, so the removal mapping is
+//' calculated once and shared. Individuals are removed through the
+//' population; new individuals' values are still queued on each structure,
+//' which must all queue the same number of them.
+//' It contains the following data members:
+//'     * _size: the number of slots in each structure
+//'     * shrink_index: an index of individuals to remove
+//'     * tombstones: free slots, if tombstones are enabled
+//'     * variables, events: the structures to resize
+class Population {
+
+    size_t _size;
+    individual_index_t shrink_index;
+    Tombstones tombstones;
+    std::vector<Variable*> variables;
+    std::vector<TargetedEvent*> events;
+
+public:
+    Population(size_t size);
+    virtual ~Population() = default;
+
+    virtual void add_variable(Variable*);
+    virtual void add_event(TargetedEvent*);
+    virtual void queue_shrink(const individual_index_t&);
+    virtual void queue_shrink(const std::vector<size_t>&);
+    virtual void enable_tombstones(const double threshold);
+    virtual const Tombstones& get_tombstones() const;
+    virtual size_t size() const;
+    virtual void resize();
+    virtual void resize(ThreadPool* pool);
+    virtual Population* clone(
+        const std::vector<Variable*>&,
+        const std::vector<TargetedEvent*>&
+    ) const;
+    virtual void save(CheckpointWriter&) const;
+    virtual void load(CheckpointReader&);
+};
+
+inline Population::Population(size_t size)
+    : _size(size), shrink_index(individual_index_t(size)) {}
+
+inline void Population::add_variable(Variable* variable) {
+    if (variable->size() != size()) {
+        Rcpp::stop("variable must be the same size as the population");
+    }
+    variables.push_back(variable);
+}
+
+inline void Population::add_event(TargetedEvent* event) {
+    if (event->size() != size()) {
+        Rcpp::stop("event must be the same size as the population");
+    }
+    events.push_back(event);
+}
+
+inline void Population::queue_shrink(const individual_index_t& index) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->Population::queue_shrink(index); });
+        return;
+    }
+    if (index.max_size() != size()) {
+        Rcpp::stop("Invalid bitset size for population shrink");
+    }
+    shrink_index |= index;
+}
+
+inline void Population::queue_shrink(const std::vector<size_t>& index) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->Population::queue_shrink(index); });
+        return;
+    }
+    for (const auto& x : index) {
+        if (x >= size()) {
+            Rcpp::stop("Invalid vector index for population shrink");
+        }
+    }
+    shrink_index.insert(index.cbegin(), index.cend());
+}
+
+//' @title keep removed individuals' slots free in every structure, see
+//' Tombstones
+inline void Population::enable_tombstones(const double threshold) {
+    tombstones.enable(threshold, size());
+    for (auto variable : variables) {
+        variable->enable_tombstones(threshold);
+    }
+    for (auto event : events) {
+        event->enable_tombstones(threshold);
+    }
+}
+
+inline const Tombstones& Population::get_tombstones() const {
+    return tombstones;
+}
+
+inline size_t Population::size() const {
+    return _size;
+}
+
+//' @title a copy of the population, including its queued removals, which
+//' resizes other structures
+//' @param new_variables the variables to resize instead of each of this
+//' population's variables, in the order they were added
+//' @param new_events the same for events
+inline Population* Population::clone(
+    const std::vector<Variable*>& new_variables,
+    const std::vector<TargetedEvent*>& new_events
+) const {
+    if (new_variables.size() != variables.size() || new_events.size() != events.size()) {
+        Rcpp::stop("a cloned population needs a structure for each of the population's structures");
+    }
+    auto population = new Population(*this);
+    population->variables = new_variables;
+    population->events = new_events;
+    return population;
+}
+
+//' @title write the population's size and queued removals, see Checkpoint.h
+//' @description the structures it resizes are saved separately
+inline void Population::save(CheckpointWriter& out) const {
+    out.write_tag("Population");
+    out.write(static_cast<uint64_t>(_size));
+    out.write(shrink_index);
+    tombstones.save(out);
+}
+
+inline void Population::load(CheckpointReader& in) {
+    in.expect_tag("Population");
+    auto saved_size = uint64_t(0);
+    in.read(saved_size);
+    _size = saved_size;
+    in.read(shrink_index);
+    tombstones.load(in);
+    expect_consistent(
+        shrink_index.max_size() == size() && tombstones.consistent(size()),
+        "Population"
+    );
+}
+
+inline void Population::resize() {
+    resize(nullptr);
+}
+
+//' @title plan this timestep's resize and apply it to every structure
+//' @description every structure is checked before any are changed, so that
+//' a mismatch does not leave the structures out of line with each other.
+//' The plan is made on the calling thread and then applied to the
+//' structures on the pool, if there is one.
+//' @param pool a pool to apply the plan on, or nullptr
+inline void Population::resize(ThreadPool* pool) {
+    auto n_new = size_t(0);
+    auto first = true;
+    const auto check = [&](size_t structure_size, size_t extend_size, size_t shrink_size) {
+        if (structure_size != size()) {
+            Rcpp::stop("structures must be the same size as the population");
+        }
+        if (shrink_size > 0) {
+            Rcpp::stop("structures in a population must be shrunk through the population");
+        }
+        if (!first && extend_size != n_new) {
+            Rcpp::stop("structures in a population must be extended by the same number of individuals");
+        }
+        n_new = extend_size;
+        first = false;
+    };
+    for (auto variable : variables) {
+        check(variable->size(), variable->get_extend_size(), variable->get_shrink_size());
+    }
+    for (auto event : events) {
+        check(event->size(), event->get_extend_size(), event->get_shrink_size());
+    }
+
+    if (shrink_index.size() == 0 && n_new == 0) {
+        return;
+    }
+    const auto plan = ResizePlan(shrink_index, n_new, tombstones);
+    auto tasks = std::vector<std::function<void ()>>();
+    for (auto variable : variables) {
+        tasks.push_back([variable, &plan]() { variable->apply_resize(plan); });
+    }
+    for (auto event : events) {
+        tasks.push_back([event, &plan]() { event->apply_resize(plan); });
+    }
+    run_tasks(pool, tasks);
+    _size = plan.final_size();
+    shrink_index = individual_index_t(size());
+}
+
+#endif /* INST_INCLUDE_POPULATION_H_ */
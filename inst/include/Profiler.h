@@ -0,0 +1,95 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_PROFILER_H_
+#define INST_INCLUDE_PROFILER_H_
+
+#include "common_types.h"
+#include "NameTable.h"
+#include <Rcpp.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//' @title a measurement of one part of a timestep
+//' It contains the following data members:
+//'     * timestep: the timestep
+//'     * phase: the phase of the simulation loop, e.g. "process" or "update"
+//'     * name: the process or structure which was run, updated or resized
+//'     * seconds: the wall time taken
+//'     * queued_updates: the number of updates applied, for variable updates
+//'     * bitset_allocations: the number of bitsets allocated on the thread
+//'     which did the work, see bitset_allocations
+struct ProfileRecord {
+    size_t timestep;
+    std::string phase;
+    std::string name;
+    double seconds;
+    size_t queued_updates;
+    size_t bitset_allocations;
+};
+
+//' @title records where the time goes in each timestep of a simulation
+//' @description The simulation loop measures each process, each event's
+//' listeners, each variable's update and each resize with `measure`, which
+//' may be called from any thread. What is measured is named from the
+//' profiler's NameTable.
+//' It contains the following data members:
+//'     * records: the measurements, in the order they finished
+//'     * lock: guards records, for measurements made on a pool
+class Profiler : public NameTable {
+    std::vector<ProfileRecord> records;
+    std::mutex lock;
+
+public:
+    virtual ~Profiler() = default;
+
+    template<class F>
+    void measure(
+        size_t timestep,
+        const std::string& phase,
+        const std::string& name,
+        F f,
+        size_t queued_updates = 0
+    );
+    virtual const std::vector<ProfileRecord>& get_records() const;
+};
+
+//' @title run `f` and record how long it took
+//' @description bitset allocations are counted on the calling thread, so
+//' work which `f` hands to other threads is timed but its allocations are
+//' not counted
+template<class F>
+inline void Profiler::measure(
+    size_t timestep,
+    const std::string& phase,
+    const std::string& name,
+    F f,
+    size_t queued_updates
+) {
+    using clock = std::chrono::steady_clock;
+    const auto allocations = bitset_allocations();
+    const auto start = clock::now();
+    f();
+    const auto seconds = std::chrono::duration<double>(clock::now() - start).count();
+    const auto record = ProfileRecord{
+        timestep,
+        phase,
+        name,
+        seconds,
+        queued_updates,
+        bitset_allocations() - allocations
+    };
+    std::lock_guard<std::mutex> guard(lock);
+    records.push_back(record);
+}
+
+inline const std::vector<ProfileRecord>& Profiler::get_records() const {
+    return records;
+}
+
+#endif /* INST_INCLUDE_PROFILER_H_ */
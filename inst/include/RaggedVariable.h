@@ -11,31 +11,96 @@
 #include "Variable.h"
 #include "common_types.h"
 #include "vector_variables.h"
+#include "CopyOnWrite.h"
 #include <Rcpp.h>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <unordered_map>
 #include <queue>
 
 // forward declaration
 template <class A>
 class RaggedVariable;
 
+//' @title can an element be found by get_index_of_containing?
+//' @description NaN is not equal to anything, including itself, so it is
+//' never found and is left out of the inverted index, where it could not be
+//' sorted or looked up
+template<class A>
+inline bool is_matchable(const A& value) {
+  return value == value;
+}
+
+//' @title sort an array's matchable elements and remove duplicates
+template<class A>
+inline void distinct_matchable(std::vector<A>& row) {
+  row.erase(
+    std::remove_if(row.begin(), row.end(), [](const A& v) { return !is_matchable(v); }),
+    row.end()
+  );
+  std::sort(row.begin(), row.end());
+  row.erase(std::unique(row.begin(), row.end()), row.end());
+}
+
 //' @title A variable class for ragged arrays
 //' @description This class takes as a template parameter the type of the elements which will
-//' be stored for each individual. The array storing each individual's container
-//' is a std::vector. It inherits from Variable.
+//' be stored for each individual. Every individual's array is stored in one
+//' contiguous buffer in compressed sparse row (CSR) layout: individual i's
+//' elements are values[offsets[i]] to values[offsets[i + 1] - 1].
+//' Updates are collected into a patch of new arrays for each updated
+//' individual, which is merged into the buffer in one pass by update(). It
+//' inherits from Variable.
 //' It contains the following data members:
-//'     * updates: a priority queue of pairs of values and indices to update
+//'     * updates: a queue of replacements, appends and removals to apply
 //'     * size: the number of elements stored (size of population)
-//'     * values: a vector of vectors of values
+//'     * values: the elements of every individual's array, in order
+//'     * offsets: where each individual's array starts in values, followed by
+//'     the total number of elements
+//'     values and offsets are shared with copies of the variable until either
+//'     changes, see CopyOnWrite.h
+//'     * postings: if the inverted index is enabled, the sorted individuals
+//'     whose arrays contain each value
 template <class A>
 class RaggedVariable : public Variable {
   
-  using update_t = std::pair<std::vector<std::vector<A>>, std::vector<size_t>>;
+  using predicate_t = std::function<bool (const A&)>;
+  enum class update_kind { replace, append, remove };
+  struct update_t {
+    update_kind kind;
+    std::vector<std::vector<A>> values;
+    std::vector<size_t> index;
+    predicate_t predicate;
+  };
+  using patch_t = std::map<size_t, std::vector<A>>;
+  using postings_t = std::unordered_map<A, std::vector<size_t>>;
   std::queue<update_t> updates;
   individual_index_t shrink_index;
   std::vector<std::vector<A>> extend_values;
+
+  void assign(const std::vector<std::vector<A>>&);
+  void fill(const std::vector<A>&);
+  void merge(patch_t&);
+  std::vector<A>& patch_row(patch_t&, size_t) const;
+  void check_index(const std::vector<std::vector<A>>&, const std::vector<size_t>&) const;
+  void append_extensions();
+  std::vector<std::ptrdiff_t> row_sources() const;
+  void rebuild(const std::vector<std::ptrdiff_t>& sources);
+
+  bool indexed = false;
+  postings_t postings;
+  void build_index();
+  void index_rows(size_t, size_t);
+  void index_patch(const patch_t&);
   
 protected:
-  std::vector<std::vector<A>> values;
+  CopyOnWrite<std::vector<A>> values;
+  CopyOnWrite<std::vector<size_t>> offsets;
+
+  std::vector<A> get_row(size_t) const;
+  std::vector<A> get_row_distinct(size_t) const;
+  size_t get_row_length(size_t) const;
 
 public:
   RaggedVariable(const std::vector<std::vector<A>>& values);
@@ -48,26 +113,115 @@ public:
   virtual std::vector<size_t> get_length() const;
   virtual std::vector<size_t> get_length(const individual_index_t& index) const;
   virtual std::vector<size_t> get_length(const std::vector<size_t>& index) const;
+
+  virtual void enable_inverted_index();
+  virtual individual_index_t get_index_of_containing(const std::vector<A>& values) const;
+  virtual individual_index_t get_index_of_length_range(const size_t a, const size_t b) const;
   
   virtual void queue_update(const std::vector<std::vector<A>>& values, const std::vector<size_t>& index);
+  virtual void queue_append(const std::vector<std::vector<A>>& values, const std::vector<size_t>& index);
+  virtual void queue_remove_if(predicate_t predicate, const std::vector<size_t>& index);
+  virtual void queue_remove(const std::vector<A>& values, const std::vector<size_t>& index);
   virtual void queue_extend(const std::vector<std::vector<A>>&);
   virtual void queue_shrink(const std::vector<size_t>&);
   virtual void queue_shrink(const individual_index_t&);
   virtual void resize() override;
+  virtual void apply_resize(const ResizePlan&) override;
+  virtual size_t get_extend_size() const override;
+  virtual size_t get_shrink_size() const override;
+  virtual size_t get_queue_size() const override;
   virtual size_t size() const override;
+  virtual Variable* clone() const override;
+  virtual void save(CheckpointWriter&) const override;
+  virtual void load(CheckpointReader&) override;
   
   virtual void update() override;
 };
 
 template<class A>
 inline RaggedVariable<A>::RaggedVariable(const std::vector<std::vector<A>>& values)
-  : shrink_index(individual_index_t(values.size())), values(values) 
-{}
+  : shrink_index(individual_index_t(values.size()))
+{
+  assign(values);
+}
+
+//' @title replace every array
+template<class A>
+inline void RaggedVariable<A>::assign(const std::vector<std::vector<A>>& new_values) {
+  auto starts = std::vector<size_t>(new_values.size() + 1);
+  starts[0] = 0;
+  for (auto i = 0u; i < new_values.size(); ++i) {
+    starts[i + 1] = starts[i] + new_values[i].size();
+  }
+  auto elements = std::vector<A>();
+  elements.reserve(starts.back());
+  for (const auto& row : new_values) {
+    elements.insert(elements.cend(), row.cbegin(), row.cend());
+  }
+  values = std::move(elements);
+  offsets = std::move(starts);
+  if (indexed) {
+    build_index();
+  }
+}
+
+//' @title replace every array with the same array
+//' @description the buffers are written directly, rather than through a
+//' vector of arrays, so filling costs no allocation per individual
+template<class A>
+inline void RaggedVariable<A>::fill(const std::vector<A>& row) {
+  const auto n = size();
+  const auto length = row.size();
+  auto starts = std::vector<size_t>(n + 1);
+  for (auto i = 0u; i <= n; ++i) {
+    starts[i] = i * length;
+  }
+  auto elements = std::vector<A>();
+  elements.reserve(n * length);
+  for (auto i = 0u; i < n; ++i) {
+    elements.insert(elements.cend(), row.cbegin(), row.cend());
+  }
+  values = std::move(elements);
+  offsets = std::move(starts);
+  if (indexed) {
+    build_index();
+  }
+}
+
+//' @title copy the array of individual i
+template<class A>
+inline std::vector<A> RaggedVariable<A>::get_row(size_t i) const {
+  const auto& elements = values.read();
+  const auto& starts = offsets.read();
+  return std::vector<A>(
+    elements.cbegin() + starts[i],
+    elements.cbegin() + starts[i + 1]
+  );
+}
+
+template<class A>
+inline size_t RaggedVariable<A>::get_row_length(size_t i) const {
+  const auto& starts = offsets.read();
+  return starts[i + 1] - starts[i];
+}
+
+//' @title the distinct elements of the array of individual i, sorted,
+//' without NaN, see is_matchable
+template<class A>
+inline std::vector<A> RaggedVariable<A>::get_row_distinct(size_t i) const {
+  auto row = get_row(i);
+  distinct_matchable(row);
+  return row;
+}
 
 //' @title get all values
 template<class A>
 inline std::vector<std::vector<A>> RaggedVariable<A>::get_values() const {
-  return values;
+  auto result = std::vector<std::vector<A>>(size());
+  for (auto i = 0u; i < size(); ++i) {
+    result[i] = get_row(i);
+  }
+  return result;
 }
 
 //' @title get values at index given by a bitset
@@ -79,7 +233,7 @@ inline std::vector<std::vector<A>> RaggedVariable<A>::get_values(const individua
   auto result = std::vector<std::vector<A>>(index.size());
   auto result_i = 0u;
   for (auto i : index) {
-    result[result_i] = values[i];
+    result[result_i] = get_row(i);
     ++result_i;
   }
   return result;
@@ -97,7 +251,7 @@ inline std::vector<std::vector<A>> RaggedVariable<A>::get_values(const std::vect
       message << index[i] << ", size of variable: " << size();
       Rcpp::stop(message.str()); 
     }
-    result[i] = values[index[i]];
+    result[i] = get_row(index[i]);
   }
   return result;
 }
@@ -107,7 +261,7 @@ template <typename T>
 inline std::vector<size_t> RaggedVariable<T>::get_length() const {
   std::vector<size_t> lengths(size());
   for (auto i = 0u; i < size(); ++i) {
-    lengths[i] = values[i].size();
+    lengths[i] = get_row_length(i);
   }
   return lengths;
 }
@@ -121,7 +275,7 @@ inline std::vector<size_t> RaggedVariable<T>::get_length(const individual_index_
   std::vector<size_t> lengths(index.size());
   auto result_i = 0u;
   for (auto i : index) {
-    lengths[result_i] = values[i].size();
+    lengths[result_i] = get_row_length(i);
     ++result_i;
   }
   return lengths;
@@ -137,20 +291,153 @@ inline std::vector<size_t> RaggedVariable<T>::get_length(const std::vector<size_
       message << "index for RaggedVariable out of range, supplied index: " << index[i] << ", size of variable: " << size();
       Rcpp::stop(message.str());
     }
-    lengths[i] = values[index[i]].size();
+    lengths[i] = get_row_length(index[i]);
   }
   return lengths;
 }
 
-//' @title queue a state update for some subset of individuals
+//' @title maintain an inverted index of the variable's elements
+//' @description the index maps each element to the individuals whose arrays
+//' contain it, so that get_index_of_containing does not have to scan every
+//' array. It is updated incrementally as arrays are patched. NaN is not
+//' indexed, since it is never found, see is_matchable.
 template<class A>
-inline void RaggedVariable<A>::queue_update(
+inline void RaggedVariable<A>::enable_inverted_index() {
+  if (!indexed) {
+    indexed = true;
+    build_index();
+  }
+}
+
+template<class A>
+inline void RaggedVariable<A>::build_index() {
+  postings.clear();
+  index_rows(0, size());
+}
+
+//' @title add individuals [first, last) to the inverted index
+//' @description individuals must come after everyone already in the index,
+//' so that each posting list stays sorted
+template<class A>
+inline void RaggedVariable<A>::index_rows(size_t first, size_t last) {
+  for (auto i = first; i < last; ++i) {
+    for (const auto& v : get_row_distinct(i)) {
+      postings[v].push_back(i);
+    }
+  }
+}
+
+//' @title update the inverted index for a patch before it is merged
+//' @description the changes for each element are collected and then merged
+//' into its posting list in one pass
+template<class A>
+inline void RaggedVariable<A>::index_patch(const patch_t& patch) {
+  using changes_t = std::pair<std::vector<size_t>, std::vector<size_t>>;
+  auto changes = std::unordered_map<A, changes_t>();
+  auto difference = std::vector<A>();
+  for (const auto& entry : patch) {
+    const auto i = entry.first;
+    const auto before = get_row_distinct(i);
+    auto after = entry.second;
+    distinct_matchable(after);
+
+    difference.clear();
+    std::set_difference(
+      after.cbegin(), after.cend(),
+      before.cbegin(), before.cend(),
+      std::back_inserter(difference)
+    );
+    for (const auto& v : difference) {
+      changes[v].first.push_back(i);
+    }
+    difference.clear();
+    std::set_difference(
+      before.cbegin(), before.cend(),
+      after.cbegin(), after.cend(),
+      std::back_inserter(difference)
+    );
+    for (const auto& v : difference) {
+      changes[v].second.push_back(i);
+    }
+  }
+
+  auto merged = std::vector<size_t>();
+  for (const auto& entry : changes) {
+    auto& posting = postings[entry.first];
+    const auto& added = entry.second.first;
+    const auto& removed = entry.second.second;
+    merged.clear();
+    std::set_difference(
+      posting.cbegin(), posting.cend(),
+      removed.cbegin(), removed.cend(),
+      std::back_inserter(merged)
+    );
+    posting.clear();
+    std::merge(
+      merged.cbegin(), merged.cend(),
+      added.cbegin(), added.cend(),
+      std::back_inserter(posting)
+    );
+    if (posting.empty()) {
+      postings.erase(entry.first);
+    }
+  }
+}
+
+//' @title return bitset giving index of individuals whose arrays contain any
+//' of a set of values
+template<class A>
+inline individual_index_t RaggedVariable<A>::get_index_of_containing(
+    const std::vector<A>& values_set
+) const {
+  auto result = individual_index_t(size());
+  if (indexed) {
+    for (const auto& v : values_set) {
+      const auto it = postings.find(v);
+      if (it != postings.end()) {
+        result.insert(it->second.cbegin(), it->second.cend());
+      }
+    }
+    return result;
+  }
+  const auto& elements = values.read();
+  const auto& starts = offsets.read();
+  for (auto i = 0u; i < size(); ++i) {
+    const auto first = elements.cbegin() + starts[i];
+    const auto last = elements.cbegin() + starts[i + 1];
+    if (std::find_first_of(first, last, values_set.cbegin(), values_set.cend()) != last) {
+      result.insert(i);
+    }
+  }
+  return result;
+}
+
+//' @title return bitset giving index of individuals whose arrays have a
+//' length in some range [a,b]
+template<class A>
+inline individual_index_t RaggedVariable<A>::get_index_of_length_range(
+    const size_t a,
+    const size_t b
+) const {
+  auto result = individual_index_t(size());
+  for (auto i = 0u; i < size(); ++i) {
+    const auto length = get_row_length(i);
+    if (!(length < a) && !(b < length)) {
+      result.insert(i);
+    }
+  }
+  for (auto i : tombstones.get_free()) {
+    result.erase(i);
+  }
+  return result;
+}
+
+//' @title check the values and index of a queued update
+template<class A>
+inline void RaggedVariable<A>::check_index(
     const std::vector<std::vector<A>>& values,
     const std::vector<size_t>& index
-) {
-  if (values.empty()) {
-    return;
-  }
+) const {
   if (values.size() > 1 && values.size() < size() && values.size() != index.size()) {
     Rcpp::stop("Mismatch between value and index length");
   }
@@ -160,13 +447,212 @@ inline void RaggedVariable<A>::queue_update(
       Rcpp::stop("Index out of bounds");
     }
   }
-  updates.push({ values, index });
+}
+
+//' @title queue a state update for some subset of individuals
+template<class A>
+inline void RaggedVariable<A>::queue_update(
+    const std::vector<std::vector<A>>& values,
+    const std::vector<size_t>& index
+) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_update(values, index); });
+    return;
+  }
+  if (values.empty()) {
+    return;
+  }
+  check_index(values, index);
+  updates.push({ update_kind::replace, values, index, predicate_t() });
+}
+
+//' @title queue elements to add to the end of some individuals' arrays
+//' @param values the elements to append for each individual, or a single
+//' vector of elements to append for all of them
+//' @param index the individuals to append to
+template<class A>
+inline void RaggedVariable<A>::queue_append(
+    const std::vector<std::vector<A>>& values,
+    const std::vector<size_t>& index
+) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_append(values, index); });
+    return;
+  }
+  if (values.empty() || index.empty()) {
+    return;
+  }
+  if (values.size() > 1 && values.size() != index.size()) {
+    Rcpp::stop("Mismatch between value and index length");
+  }
+  check_index(values, index);
+  updates.push({ update_kind::append, values, index, predicate_t() });
+}
+
+//' @title queue the removal of elements from some individuals' arrays
+//' @param predicate elements for which this returns true are removed
+//' @param index the individuals to remove elements from
+template<class A>
+inline void RaggedVariable<A>::queue_remove_if(
+    predicate_t predicate,
+    const std::vector<size_t>& index
+) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_remove_if(predicate, index); });
+    return;
+  }
+  if (index.empty()) {
+    return;
+  }
+  check_index(std::vector<std::vector<A>>(), index);
+  updates.push({
+    update_kind::remove,
+    std::vector<std::vector<A>>(),
+    index,
+    predicate
+  });
+}
+
+//' @title queue the removal of every element equal to one of `values` from
+//' some individuals' arrays
+template<class A>
+inline void RaggedVariable<A>::queue_remove(
+    const std::vector<A>& values,
+    const std::vector<size_t>& index
+) {
+  queue_remove_if([values](const A& x) {
+    return std::find(values.cbegin(), values.cend(), x) != values.cend();
+  }, index);
+}
+
+//' @title get the new array for individual i, starting from their current
+//' array if it has not been patched yet
+template<class A>
+inline std::vector<A>& RaggedVariable<A>::patch_row(patch_t& patch, size_t i) const {
+  auto it = patch.find(i);
+  if (it == patch.end()) {
+    it = patch.insert({ i, get_row(i) }).first;
+  }
+  return it->second;
 }
 
 //' @title apply all queued state updates in FIFO order
+//' @description updates to a subset of individuals are collected into a patch,
+//' later updates applying on top of earlier ones, and merged into the buffer
+//' once. Updates to every individual replace the buffer directly.
 template<class A>
 inline void RaggedVariable<A>::update() {
-    vector_update(updates, values);
+  auto patch = patch_t();
+  while(updates.size() > 0) {
+    const auto& update = updates.front();
+    const auto& new_values = update.values;
+    const auto& index = update.index;
+    const auto value_fill = (new_values.size() == 1);
+
+    switch(update.kind) {
+    case update_kind::replace:
+      if (index.size() == 0) {
+        // every array is replaced, so earlier patches are discarded
+        patch.clear();
+        if (value_fill) {
+          fill(new_values[0]);
+        } else {
+          assign(new_values);
+        }
+      } else {
+        for (auto i = 0u; i < index.size(); ++i) {
+          patch[index[i]] = value_fill ? new_values[0] : new_values[i];
+        }
+      }
+      break;
+    case update_kind::append:
+      for (auto i = 0u; i < index.size(); ++i) {
+        const auto& appended = value_fill ? new_values[0] : new_values[i];
+        auto& row = patch_row(patch, index[i]);
+        row.insert(row.cend(), appended.cbegin(), appended.cend());
+      }
+      break;
+    case update_kind::remove:
+      for (auto i : index) {
+        auto& row = patch_row(patch, i);
+        row.erase(
+          std::remove_if(row.begin(), row.end(), update.predicate),
+          row.end()
+        );
+      }
+      break;
+    }
+    updates.pop();
+  }
+  merge(patch);
+}
+
+//' @title merge new arrays for some individuals into the buffer
+//' @description arrays which keep their length are overwritten in place,
+//' otherwise the buffer is rebuilt in one pass, copying the elements between
+//' patched individuals as contiguous blocks
+template<class A>
+inline void RaggedVariable<A>::merge(patch_t& patch) {
+  if (patch.empty()) {
+    return;
+  }
+  if (indexed) {
+    index_patch(patch);
+  }
+
+  auto same_lengths = true;
+  for (const auto& entry : patch) {
+    if (entry.second.size() != get_row_length(entry.first)) {
+      same_lengths = false;
+      break;
+    }
+  }
+  if (same_lengths) {
+    auto& elements = values.write();
+    const auto& starts = offsets.read();
+    for (const auto& entry : patch) {
+      std::copy(
+        entry.second.cbegin(),
+        entry.second.cend(),
+        elements.begin() + starts[entry.first]
+      );
+    }
+    return;
+  }
+
+  const auto& elements = values.read();
+  auto& starts = offsets.write();
+  auto total = elements.size();
+  for (const auto& entry : patch) {
+    total = total + entry.second.size() - get_row_length(entry.first);
+  }
+  auto merged = std::vector<A>();
+  merged.reserve(total);
+  // offsets up to `copied` have been moved by `shift`, the rest have not
+  auto copied = size_t(0);
+  auto shift = std::ptrdiff_t(0);
+  for (const auto& entry : patch) {
+    const auto i = entry.first;
+    // individuals before i are unchanged apart from their offsets
+    merged.insert(
+      merged.cend(),
+      elements.cbegin() + (starts[copied] - shift),
+      elements.cbegin() + (starts[i] - (i == copied ? shift : 0))
+    );
+    for (auto j = copied + 1; j <= i; ++j) {
+      starts[j] += shift;
+    }
+    const auto old_length = starts[i + 1] - (starts[i] - shift);
+    merged.insert(merged.cend(), entry.second.cbegin(), entry.second.cend());
+    shift += entry.second.size() - old_length;
+    starts[i + 1] = starts[i] + entry.second.size();
+    copied = i + 1;
+  }
+  merged.insert(merged.cend(), elements.cbegin() + (starts[copied] - shift), elements.cend());
+  for (auto j = copied + 1; j <= size(); ++j) {
+    starts[j] += shift;
+  }
+  values = std::move(merged);
 }
 
 //' @title queue new values to add to the variable
@@ -174,6 +660,10 @@ template<class A>
 inline void RaggedVariable<A>::queue_extend(
     const std::vector<std::vector<A>>& new_values
 ) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_extend(new_values); });
+    return;
+  }
   extend_values.insert(
     extend_values.cend(),
     new_values.cbegin(),
@@ -186,6 +676,10 @@ template<class A>
 inline void RaggedVariable<A>::queue_shrink(
     const individual_index_t& index
 ) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_shrink(index); });
+    return;
+  }
   if (index.max_size() != size()) {
     Rcpp::stop("Invalid bitset size for variable shrink");
   }
@@ -197,6 +691,10 @@ template<class A>
 inline void RaggedVariable<A>::queue_shrink(
     const std::vector<size_t>& index
 ) {
+  if (auto buffer = staging_buffer()) {
+    buffer->emplace_back([=]() { this->RaggedVariable<A>::queue_shrink(index); });
+    return;
+  }
   for (const auto& x : index) {
     if (x >= size()) {
       Rcpp::stop("Invalid vector index for variable shrink");
@@ -205,14 +703,205 @@ inline void RaggedVariable<A>::queue_shrink(
   shrink_index.insert(index.cbegin(), index.cend());
 }
 
+//' @title apply the queued shrinks and extensions
+//' @description without tombstones, the arrays are resized directly; a
+//' ResizePlan is only made when the tombstones allocate the slots
 template<class A>
 inline void RaggedVariable<A>::resize() {
-    resize_vector(values, shrink_index, extend_values);
+  if (shrink_index.size() == 0 && extend_values.size() == 0) {
+    return;
+  }
+  if (tombstones.enabled()) {
+    apply_resize(ResizePlan(shrink_index, extend_values.size(), tombstones));
+    return;
+  }
+  if (shrink_index.size() == 0) {
+    append_extensions();
+  } else {
+    auto sources = row_sources();
+    auto new_sources = std::vector<std::ptrdiff_t>(extend_values.size());
+    for (auto k = 0u; k < new_sources.size(); ++k) {
+      new_sources[k] = -static_cast<std::ptrdiff_t>(k + 1);
+    }
+    resize_vector(sources, shrink_index, new_sources);
+    rebuild(sources);
+  }
+  shrink_index.reset(size());
+}
+
+//' @title resize with a plan, the variable's own queued shrinks are discarded
+//' @description if individuals are only appended, their arrays are appended to
+//' the buffer. Otherwise the source of every array is worked out with the
+//' same plan as other vector-based variables, and the buffer is rebuilt in
+//' one pass.
+template<class A>
+inline void RaggedVariable<A>::apply_resize(const ResizePlan& plan) {
+  if (!plan.empty()) {
+    auto appending = plan.removed_vector.empty() && plan.compacted_vector.empty();
+    for (auto slot : plan.slots) {
+      appending = appending && slot >= size();
+    }
+    if (appending) {
+      append_extensions();
+    } else {
+      auto sources = row_sources();
+      auto new_sources = std::vector<std::ptrdiff_t>(extend_values.size());
+      for (auto k = 0u; k < new_sources.size(); ++k) {
+        new_sources[k] = -static_cast<std::ptrdiff_t>(k + 1);
+      }
+      resize_vector(sources, plan, new_sources);
+      rebuild(sources);
+    }
+    follow_tombstones(plan);
+  }
+  shrink_index.reset(size());
+}
+
+//' @title append the queued new arrays to the buffer
+template<class A>
+inline void RaggedVariable<A>::append_extensions() {
+  const auto first = size();
+  auto& elements = values.write();
+  auto& starts = offsets.write();
+  for (const auto& row : extend_values) {
+    elements.insert(elements.cend(), row.cbegin(), row.cend());
+    starts.push_back(elements.size());
+  }
+  extend_values.clear();
+  if (indexed) {
+    index_rows(first, size());
+  }
+}
+
+//' @title the source of each array before resizing, i + 1 for individual i
+template<class A>
+inline std::vector<std::ptrdiff_t> RaggedVariable<A>::row_sources() const {
+  auto sources = std::vector<std::ptrdiff_t>(size());
+  for (auto i = 0u; i < size(); ++i) {
+    sources[i] = i + 1;
+  }
+  return sources;
+}
+
+//' @title rebuild the buffer from the source of each array
+//' @param sources 0 for an empty array, i + 1 for individual i and -(k + 1)
+//' for new individual k
+template<class A>
+inline void RaggedVariable<A>::rebuild(const std::vector<std::ptrdiff_t>& sources) {
+  const auto& elements = values.read();
+  const auto& starts = offsets.read();
+  auto resized = std::vector<A>();
+  auto resized_offsets = std::vector<size_t>(sources.size() + 1);
+  resized_offsets[0] = 0;
+  for (auto i = 0u; i < sources.size(); ++i) {
+    const auto source = sources[i];
+    if (source > 0) {
+      resized.insert(
+        resized.cend(),
+        elements.cbegin() + starts[source - 1],
+        elements.cbegin() + starts[source]
+      );
+    } else if (source < 0) {
+      const auto& row = extend_values[-source - 1];
+      resized.insert(resized.cend(), row.cbegin(), row.cend());
+    }
+    resized_offsets[i + 1] = resized.size();
+  }
+  values = std::move(resized);
+  offsets = std::move(resized_offsets);
+  extend_values.clear();
+  if (indexed) {
+    build_index();
+  }
+}
+
+template<class A>
+inline size_t RaggedVariable<A>::get_extend_size() const {
+  return extend_values.size();
+}
+
+template<class A>
+inline size_t RaggedVariable<A>::get_shrink_size() const {
+  return shrink_index.size();
+}
+
+template<class A>
+inline size_t RaggedVariable<A>::get_queue_size() const {
+  return updates.size();
 }
 
 template<class A>
 inline size_t RaggedVariable<A>::size() const {
-  return values.size();
+  return offsets.read().size() - 1;
+}
+
+template<class A>
+inline Variable* RaggedVariable<A>::clone() const {
+  return new RaggedVariable<A>(*this);
+}
+
+//' @title write the variable's state, see Checkpoint.h
+//' @description queued removals are predicates, which cannot be written
+template<class A>
+inline void RaggedVariable<A>::save(CheckpointWriter& out) const {
+  out.write_tag("RaggedVariable");
+  out.write_type<A>();
+  out.write(values.read());
+  out.write(offsets.read());
+  write_queue(out, updates, [&](const update_t& update) {
+    if (update.kind == update_kind::remove) {
+      Rcpp::stop("a RaggedVariable with queued removals cannot be checkpointed");
+    }
+    out.write(static_cast<uint8_t>(update.kind));
+    out.write(update.values);
+    out.write(update.index);
+  });
+  out.write(shrink_index);
+  out.write(extend_values);
+  tombstones.save(out);
+}
+
+//' @title replace the variable's state with one written by `save`
+//' @description the inverted index, if enabled, is rebuilt
+template<class A>
+inline void RaggedVariable<A>::load(CheckpointReader& in) {
+  in.expect_tag("RaggedVariable");
+  in.expect_type<A>();
+  auto elements = std::vector<A>();
+  in.read(elements);
+  auto starts = std::vector<size_t>();
+  in.read(starts);
+  expect_consistent(
+    !starts.empty() && starts.front() == 0 && starts.back() == elements.size() &&
+      std::is_sorted(starts.cbegin(), starts.cend()),
+    "RaggedVariable"
+  );
+  values = std::move(elements);
+  offsets = std::move(starts);
+  read_queue(in, updates, [&]() {
+    auto kind = uint8_t(0);
+    in.read(kind);
+    auto update = update_t{ static_cast<update_kind>(kind), {}, {}, predicate_t() };
+    in.read(update.values);
+    in.read(update.index);
+    // removals are never saved, since their predicates cannot be
+    expect_consistent(
+      (update.kind == update_kind::replace || update.kind == update_kind::append) &&
+        queued_update_fits(update.values.size(), update.index, size()),
+      "RaggedVariable"
+    );
+    return update;
+  });
+  in.read(shrink_index);
+  in.read(extend_values);
+  tombstones.load(in);
+  expect_consistent(
+    shrink_index.max_size() == size() && tombstones.consistent(size()),
+    "RaggedVariable"
+  );
+  if (indexed) {
+    build_index();
+  }
 }
 
 #endif
@@ -0,0 +1,458 @@
+/*
+ * Random.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_RANDOM_H_
+#define INST_INCLUDE_RANDOM_H_
+
+#include "ThreadPool.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+//' @title a xoshiro256** random number generator
+//' @description A fast generator with 256 bits of state (Blackman & Vigna,
+//' 2018). `jump` advances the state by 2^128 draws, so streams made by
+//' jumping from the same seed never overlap in practice. Besides raw 64 bit
+//' draws, it has batched uniform, exponential, binomial and multinomial
+//' draws and sampling without replacement. It does not use the R API, so it
+//' can be used on any thread.
+class Xoshiro256 {
+    std::array<uint64_t, 4> s;
+
+public:
+    using result_type = uint64_t;
+
+    Xoshiro256(uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()();
+    void jump();
+
+    double uniform();
+    std::vector<double> uniform(size_t count);
+    size_t index(size_t n);
+    double exponential(double rate);
+    std::vector<double> exponential(size_t count, double rate);
+    size_t binomial(size_t n, double p);
+    std::vector<size_t> binomial(size_t count, size_t n, double p);
+    std::vector<size_t> multinomial(size_t n, const std::vector<double>& probs);
+    std::vector<size_t> sample(size_t n, size_t k);
+};
+
+inline uint64_t rotate_left(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+//' @title seed the state from a 64 bit seed with splitmix64
+inline Xoshiro256::Xoshiro256(uint64_t seed) {
+    for (auto& x : s) {
+        auto z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        x = z ^ (z >> 31);
+    }
+}
+
+inline Xoshiro256::result_type Xoshiro256::operator()() {
+    const auto result = rotate_left(s[1] * 5, 7) * 9;
+    const auto t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], 45);
+    return result;
+}
+
+//' @title advance the state by 2^128 draws
+inline void Xoshiro256::jump() {
+    static const uint64_t JUMP[] = {
+        0x180ec6d33cfd0abaULL,
+        0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL,
+        0x39abdc4529b1661cULL
+    };
+    auto jumped = std::array<uint64_t, 4>{ 0, 0, 0, 0 };
+    for (auto word : JUMP) {
+        for (auto b = 0; b < 64; ++b) {
+            if (word & (uint64_t(1) << b)) {
+                for (auto i = 0u; i < s.size(); ++i) {
+                    jumped[i] ^= s[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    s = jumped;
+}
+
+//' @title a uniform draw in (0, 1)
+//' @description like R's runif, never returns 0 or 1
+inline double Xoshiro256::uniform() {
+    return (static_cast<double>((*this)() >> 11) + 0.5) / 9007199254740992.;
+}
+
+inline std::vector<double> Xoshiro256::uniform(size_t count) {
+    auto result = std::vector<double>(count);
+    for (auto& x : result) {
+        x = uniform();
+    }
+    return result;
+}
+
+//' @title a uniform draw from {0, ..., n - 1}
+//' @description rejects the draws which would make low values more likely
+inline size_t Xoshiro256::index(size_t n) {
+    const auto threshold = (-static_cast<uint64_t>(n)) % n;
+    auto x = (*this)();
+    while (x < threshold) {
+        x = (*this)();
+    }
+    return x % n;
+}
+
+inline double Xoshiro256::exponential(double rate) {
+    return -std::log(uniform()) / rate;
+}
+
+inline std::vector<double> Xoshiro256::exponential(size_t count, double rate) {
+    auto result = std::vector<double>(count);
+    for (auto& x : result) {
+        x = exponential(rate);
+    }
+    return result;
+}
+
+//' @title log(gamma(x)) for x > 0
+//' @description a Stirling series, shifted for small x. std::lgamma is not
+//' thread safe on every platform.
+inline double log_gamma(double x) {
+    static const double a[10] = {
+        8.333333333333333e-02, -2.777777777777778e-03,
+        7.936507936507937e-04, -5.952380952380952e-04,
+        8.417508417508418e-04, -1.917526917526918e-03,
+        6.410256410256410e-03, -2.955065359477124e-02,
+        1.796443723688307e-01, -1.39243221690590e+00
+    };
+    if (x == 1. || x == 2.) {
+        return 0.;
+    }
+    auto shift = 0;
+    if (x < 7.) {
+        shift = static_cast<int>(7. - x);
+    }
+    auto x0 = x + shift;
+    const auto x2 = 1. / (x0 * x0);
+    auto series = a[9];
+    for (auto k = 8; k >= 0; --k) {
+        series = series * x2 + a[k];
+    }
+    auto result = series / x0 + 0.9189385332046727 + (x0 - 0.5) * std::log(x0) - x0;
+    for (auto k = 0; k < shift; ++k) {
+        x0 -= 1.;
+        result -= std::log(x0);
+    }
+    return result;
+}
+
+//' @title a binomial draw
+//' @description counts geometric waiting times between successes when the
+//' mean is small, otherwise uses transformed rejection with squeeze (BTRS,
+//' Hormann, 1993)
+inline size_t Xoshiro256::binomial(size_t n, double p) {
+    if (n == 0 || !(p > 0.)) {
+        return 0;
+    }
+    if (p >= 1.) {
+        return n;
+    }
+    if (p > 0.5) {
+        return n - binomial(n, 1. - p);
+    }
+    if (n * p < 10.) {
+        const auto log_q = std::log1p(-p);
+        auto trials = 0.;
+        auto successes = size_t(0);
+        while (true) {
+            trials += std::ceil(std::log(uniform()) / log_q);
+            if (trials > n) {
+                return successes;
+            }
+            ++successes;
+        }
+    }
+    const auto q = 1. - p;
+    const auto spq = std::sqrt(n * p * q);
+    const auto b = 1.15 + 2.53 * spq;
+    const auto a = -0.0873 + 0.0248 * b + 0.01 * p;
+    const auto c = n * p + 0.5;
+    const auto v_r = 0.92 - 4.2 / b;
+    const auto alpha = (2.83 + 5.1 / b) * spq;
+    const auto lpq = std::log(p / q);
+    const auto m = std::floor((n + 1) * p);
+    const auto h = log_gamma(m + 1.) + log_gamma(n - m + 1.);
+    while (true) {
+        const auto u = uniform() - 0.5;
+        auto v = uniform();
+        const auto us = 0.5 - std::fabs(u);
+        const auto k = std::floor((2. * a / us + b) * u + c);
+        if (k < 0. || k > n) {
+            continue;
+        }
+        if (us >= 0.07 && v <= v_r) {
+            return static_cast<size_t>(k);
+        }
+        v = std::log(v * alpha / (a / (us * us) + b));
+        if (v <= h - log_gamma(k + 1.) - log_gamma(n - k + 1.) + (k - m) * lpq) {
+            return static_cast<size_t>(k);
+        }
+    }
+}
+
+inline std::vector<size_t> Xoshiro256::binomial(size_t count, size_t n, double p) {
+    auto result = std::vector<size_t>(count);
+    for (auto& x : result) {
+        x = binomial(n, p);
+    }
+    return result;
+}
+
+//' @title a multinomial draw
+//' @description draws each count from a binomial, conditional on the
+//' counts before it
+//' @param n the number of trials
+//' @param probs the probability of each outcome, which are normalised
+//' @return the number of trials with each outcome
+inline std::vector<size_t> Xoshiro256::multinomial(
+    size_t n,
+    const std::vector<double>& probs
+) {
+    auto result = std::vector<size_t>(probs.size(), 0);
+    auto remaining_p = 0.;
+    for (auto p : probs) {
+        remaining_p += p;
+    }
+    for (auto i = 0u; i < probs.size() && n > 0; ++i) {
+        if (i + 1 == probs.size()) {
+            result[i] = n;
+            break;
+        }
+        const auto p = remaining_p > 0. ? std::min(probs[i] / remaining_p, 1.) : 0.;
+        result[i] = binomial(n, p);
+        n -= result[i];
+        remaining_p -= probs[i];
+    }
+    return result;
+}
+
+//' @title k distinct draws from {0, ..., n - 1}
+//' @description uses Floyd's algorithm on whichever of the sample or the
+//' values left out is smaller
+//' @return the sample, sorted
+inline std::vector<size_t> Xoshiro256::sample(size_t n, size_t k) {
+    const auto complement = k > n / 2;
+    const auto draws = complement ? n - k : k;
+    auto chosen = std::unordered_set<size_t>();
+    for (auto j = n - draws; j < n; ++j) {
+        const auto t = index(j + 1);
+        if (!chosen.insert(t).second) {
+            chosen.insert(j);
+        }
+    }
+    auto result = std::vector<size_t>();
+    result.reserve(k);
+    if (complement) {
+        for (auto i = 0u; i < n; ++i) {
+            if (chosen.find(i) == chosen.end()) {
+                result.push_back(i);
+            }
+        }
+    } else {
+        result.assign(chosen.cbegin(), chosen.cend());
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+//' @title which generator sampling in C++ uses
+//' @description R's generator is used unless a seed has been set for the
+//' native generator. Each native stream starts 2^128 draws after the last.
+//' It contains the following data members:
+//'     * native: whether to use the native generator
+//'     * generation: the number of times the seed has been set
+//'     * next: the start of the next stream
+//'     * lock: held while making a stream
+struct RandomSettings {
+    std::atomic<bool> native{false};
+    std::atomic<size_t> generation{0};
+    Xoshiro256 next{0};
+    std::mutex lock;
+};
+
+inline RandomSettings& random_settings() {
+    static RandomSettings settings;
+    return settings;
+}
+
+//' @title use the native generator, from a seed
+inline void set_random_seed(uint64_t seed) {
+    auto& settings = random_settings();
+    std::lock_guard<std::mutex> guard(settings.lock);
+    settings.next = Xoshiro256(seed);
+    settings.native = true;
+    ++settings.generation;
+}
+
+//' @title go back to R's generator
+inline void use_r_random() {
+    auto& settings = random_settings();
+    std::lock_guard<std::mutex> guard(settings.lock);
+    settings.native = false;
+    ++settings.generation;
+}
+
+inline bool native_random() {
+    return random_settings().native;
+}
+
+//' @title the state which new native streams are made from
+//' @description restoring a saved state with `set_random_state` makes every
+//' stream again, so that draws after the restore repeat those after the save,
+//' as long as the same streams are asked for in the same order
+inline Xoshiro256 get_random_state() {
+    auto& settings = random_settings();
+    std::lock_guard<std::mutex> guard(settings.lock);
+    return settings.next;
+}
+
+//' @title use the native generator, from a saved state
+inline void set_random_state(const Xoshiro256& state) {
+    auto& settings = random_settings();
+    std::lock_guard<std::mutex> guard(settings.lock);
+    settings.next = state;
+    settings.native = true;
+    ++settings.generation;
+}
+
+//' @title make a new native stream
+inline Xoshiro256 new_random_stream() {
+    auto& settings = random_settings();
+    std::lock_guard<std::mutex> guard(settings.lock);
+    auto stream = settings.next;
+    settings.next.jump();
+    return stream;
+}
+
+//' @title the stream native draws on this thread come from, if set
+inline Xoshiro256*& random_scope_stream() {
+    static thread_local Xoshiro256* stream = nullptr;
+    return stream;
+}
+
+//' @title draw from a given stream on this thread while in scope
+//' @description the native loop gives each process its own stream, so
+//' draws do not depend on the order processes run in
+class RandomScope {
+    Xoshiro256* previous;
+
+public:
+    RandomScope(Xoshiro256* stream);
+    RandomScope(const RandomScope&) = delete;
+    RandomScope& operator=(const RandomScope&) = delete;
+    virtual ~RandomScope();
+};
+
+inline RandomScope::RandomScope(Xoshiro256* stream)
+    : previous(random_scope_stream()) {
+    random_scope_stream() = stream;
+}
+
+inline RandomScope::~RandomScope() {
+    random_scope_stream() = previous;
+}
+
+//' @title the native stream for this thread
+//' @description the stream in scope, or else this thread's own stream, which
+//' is made the first time the thread draws after the seed is set
+inline Xoshiro256& random_stream() {
+    if (random_scope_stream() != nullptr) {
+        return *random_scope_stream();
+    }
+    static thread_local std::unique_ptr<Xoshiro256> stream;
+    static thread_local size_t generation = 0;
+    const size_t current = random_settings().generation;
+    if (stream == nullptr || generation != current) {
+        stream.reset(new Xoshiro256(new_random_stream()));
+        generation = current;
+    }
+    return *stream;
+}
+
+//' @title stop if R's generator is about to be used from a pool task
+//' @description R's generator may only be used on R's thread, and a task
+//' may be running on a worker. The error is a C++ one, since calling R to
+//' raise an error from a worker is no safer.
+inline void check_r_random_thread() {
+    if (in_pool_task()) {
+        throw std::runtime_error(
+            "R's random number generator cannot be used on other threads, see set_native_seed"
+        );
+    }
+}
+
+//' @title uniform draws in (0, 1) for sampling in C++
+//' @description these random_* functions draw from the native stream for
+//' this thread if a seed has been set for it, otherwise from R's generator,
+//' which may only be used on R's thread
+inline std::vector<double> random_uniform(size_t n) {
+    if (native_random()) {
+        return random_stream().uniform(n);
+    }
+    check_r_random_thread();
+    const auto drawn = Rcpp::runif(n);
+    return std::vector<double>(drawn.begin(), drawn.end());
+}
+
+//' @title a binomial draw for sampling in C++
+inline size_t random_binomial(size_t n, double p) {
+    if (native_random()) {
+        return random_stream().binomial(n, p);
+    }
+    check_r_random_thread();
+    return Rcpp::rbinom(1, n, p)[0];
+}
+
+//' @title k distinct draws from {0, ..., n - 1} for sampling in C++
+//' @return the sample, sorted
+inline std::vector<size_t> random_sample(size_t n, size_t k) {
+    if (native_random()) {
+        return random_stream().sample(n, k);
+    }
+    check_r_random_thread();
+    const auto drawn = Rcpp::sample(
+        n,
+        k,
+        false, // replacement
+        R_NilValue, // evenly distributed
+        false // one based
+    );
+    auto result = std::vector<size_t>(drawn.begin(), drawn.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+#endif /* INST_INCLUDE_RANDOM_H_ */
@@ -0,0 +1,73 @@
+/*
+ * Render.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_RENDER_H_
+#define INST_INCLUDE_RENDER_H_
+
+#include "Staging.h"
+#include <Rcpp.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//' @title outputs rendered by C++ processes
+//' @description This is the C++ side of an R Render object, so that C++
+//' processes can render without calling R. Values which have not been
+//' rendered are NA, so that they can be told apart from a rendered NaN.
+//' Renders made by processes running in parallel are staged, see Staging.h.
+//' It contains the following data members:
+//'     * timesteps: the number of timesteps to render
+//'     * names: the names of the outputs, in the order they were first rendered
+//'     * vectors: the value of each output on each timestep
+class Render {
+    size_t timesteps;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::vector<double>> vectors;
+
+public:
+    Render(size_t timesteps);
+    virtual ~Render() = default;
+
+    virtual void render(const std::string& name, double value, size_t timestep);
+    virtual const std::vector<std::string>& get_names() const;
+    virtual const std::vector<double>& get_values(const std::string& name) const;
+};
+
+inline Render::Render(size_t timesteps) : timesteps(timesteps) {}
+
+//' @title store a value for an output
+//' @param timestep the timestep, counted from one as in R
+inline void Render::render(const std::string& name, double value, size_t timestep) {
+    if (auto buffer = staging_buffer()) {
+        buffer->emplace_back([=]() { this->Render::render(name, value, timestep); });
+        return;
+    }
+    if (name == "timestep") {
+        Rcpp::stop("Please don't name your variable 'timestep'");
+    }
+    if (timestep < 1 || timestep > timesteps) {
+        Rcpp::stop("timestep out of range for render");
+    }
+    auto it = vectors.find(name);
+    if (it == vectors.end()) {
+        names.push_back(name);
+        it = vectors.emplace(
+            name,
+            std::vector<double>(timesteps, NA_REAL)
+        ).first;
+    }
+    it->second[timestep - 1] = value;
+}
+
+inline const std::vector<std::string>& Render::get_names() const {
+    return names;
+}
+
+inline const std::vector<double>& Render::get_values(const std::string& name) const {
+    return vectors.at(name);
+}
+
+#endif /* INST_INCLUDE_RENDER_H_ */
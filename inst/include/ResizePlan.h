@@ -0,0 +1,91 @@
+/*
+ * ResizePlan.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_RESIZE_PLAN_H_
+#define INST_INCLUDE_RESIZE_PLAN_H_
+
+#include "Tombstones.h"
+#include "common_types.h"
+#include <Rcpp.h>
+
+//' @title the individuals to remove and add in one resize
+//' @description A plan is calculated once from the individuals to remove and
+//' the number of new individuals, and can then be applied to any number of
+//' structures of the same size, which all end up with the same individuals
+//' in the same slots. A resize happens in three steps:
+//'     1. removed individuals are shrunk away, or freed if tombstones are
+//'     enabled
+//'     2. new individuals are put into `slots`, which are in [0, allocated_size)
+//'     3. if tombstones are enabled, the `compacted` free slots are shrunk away
+//' It contains the following data members:
+//'     * size: the number of slots before resizing
+//'     * removed, removed_vector: the individuals to remove
+//'     * n_new: the number of new individuals
+//'     * slots: the slot for each new individual
+//'     * allocated_size: the number of slots after step 2
+//'     * compacted, compacted_vector: the free slots to compact away
+//'     * tombstones: the tombstones after resizing, or nullptr if they are not
+//'     enabled
+struct ResizePlan {
+    size_t size;
+    individual_index_t removed;
+    std::vector<size_t> removed_vector;
+    size_t n_new;
+    std::vector<size_t> slots;
+    size_t allocated_size;
+    individual_index_t compacted = individual_index_t(0);
+    std::vector<size_t> compacted_vector;
+    const Tombstones* tombstones = nullptr;
+
+    ResizePlan(const individual_index_t& removed, size_t n_new, Tombstones& tombstones);
+
+    bool empty() const;
+    size_t final_size() const;
+};
+
+//' @title plan a resize
+//' @param removed the individuals to remove
+//' @param n_new the number of new individuals
+//' @param tombstones the structure's tombstones, which allocate the slots if
+//' they are enabled
+inline ResizePlan::ResizePlan(
+    const individual_index_t& removed,
+    size_t n_new,
+    Tombstones& tombstones
+) : size(removed.max_size()),
+    removed(removed),
+    removed_vector(removed.cbegin(), removed.cend()),
+    n_new(n_new) {
+    if (tombstones.enabled()) {
+        slots = tombstones.allocate(removed, n_new);
+        allocated_size = tombstones.size();
+        if (tombstones.should_compact()) {
+            compacted = tombstones.get_free();
+            compacted_vector.assign(compacted.cbegin(), compacted.cend());
+            tombstones.compacted();
+        }
+        this->tombstones = &tombstones;
+    } else {
+        const auto shrunk_size = size - removed_vector.size();
+        slots.resize(n_new);
+        for (auto i = 0u; i < n_new; ++i) {
+            slots[i] = shrunk_size + i;
+        }
+        allocated_size = shrunk_size + n_new;
+    }
+}
+
+//' @title does the plan leave structures unchanged?
+inline bool ResizePlan::empty() const {
+    return removed_vector.empty() && n_new == 0;
+}
+
+//' @title the number of slots after resizing
+inline size_t ResizePlan::final_size() const {
+    return allocated_size - compacted_vector.size();
+}
+
+#endif /* INST_INCLUDE_RESIZE_PLAN_H_ */
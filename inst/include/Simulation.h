@@ -0,0 +1,428 @@
+/*
+ * Simulation.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_SIMULATION_H_
+#define INST_INCLUDE_SIMULATION_H_
+
+#include "common_types.h"
+#include "Variable.h"
+#include "Event.h"
+#include "Population.h"
+#include "ThreadPool.h"
+#include "Staging.h"
+#include "Random.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <memory>
+
+//' @title the structures which a process reads and queues changes to
+//' @description Structures are identified by their address. Processes which
+//' have not declared what they access conflict with every other process.
+//' It contains the following data members:
+//'     * declared: whether the process has declared what it accesses
+//'     * reads: the structures the process reads
+//'     * writes: the structures the process queues changes to
+struct ProcessAccess {
+    bool declared = false;
+    std::vector<const void*> reads;
+    std::vector<const void*> writes;
+
+    bool conflicts(const ProcessAccess&) const;
+};
+
+//' @title can two processes not run at the same time?
+//' @description they conflict if either queues changes to a structure the
+//' other reads. Processes which only queue changes to the same structures do
+//' not conflict, because changes made in parallel are staged and applied in
+//' order, see Staging.h.
+inline bool ProcessAccess::conflicts(const ProcessAccess& other) const {
+    if (!declared || !other.declared) {
+        return true;
+    }
+    const auto contains = [](const std::vector<const void*>& structures, const void* x) {
+        return std::find(structures.cbegin(), structures.cend(), x) != structures.cend();
+    };
+    for (const auto x : writes) {
+        if (contains(other.reads, x)) {
+            return true;
+        }
+    }
+    for (const auto x : other.writes) {
+        if (contains(reads, x)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//' @title a simulation loop which runs in C++
+//' @description This class runs the same phases in the same order as
+//' `simulation_loop` in R, but without going through R for each object on
+//' each timestep. Processes and listeners are stored as C++ functions, which
+//' only call back into R if they wrap an R function.
+//' With more than one thread, processes which do not conflict (see
+//' ProcessAccess) run at the same time. Processes are split into stages,
+//' where each process comes in a later stage than every earlier process it
+//' conflicts with. The changes made by each process in a stage are staged
+//' and applied in process order once the stage has finished, so the changes
+//' queued to each structure are queued in the same order as if the processes
+//' ran one after another. Declared processes which run alone are staged in
+//' the same way. Updates and resizes are also run in parallel, see
+//' update_and_resize. With the native random number generator, each process
+//' draws from its own stream, so results do not depend on the number of
+//' threads. A Profiler, if set, measures each part of each timestep, and a
+//' Tracer, if set, records them on a timeline.
+//' It contains the following data members:
+//'     * processes: the processes to run on each timestep
+//'     * access: what each process accesses
+//'     * threads: the number of threads to run processes on
+//'     * events: each event and the listeners to call when it triggers
+//'     * targeted_events: the events to resize
+//'     * variables: the variables to update and resize
+//'     * populations: the populations to resize
+//'     * streams: each process's random stream, if the native generator is
+//'     used
+//'     * profiler: the profiler to measure each timestep with, or nullptr
+//'     * tracer: the tracer to record each timestep with, or nullptr
+//'     * timestep: the timestep being run
+class Simulation {
+
+    using event_entry_t = std::pair<EventBase*, std::vector<listener_t>>;
+    std::vector<process_t> processes;
+    std::vector<ProcessAccess> access;
+    size_t threads = 1;
+    std::vector<event_entry_t> events;
+    std::vector<TargetedEvent*> targeted_events;
+    std::vector<Variable*> variables;
+    std::vector<Population*> populations;
+    std::vector<Xoshiro256> streams;
+    Profiler* profiler = nullptr;
+    Tracer* tracer = nullptr;
+    size_t timestep = 0;
+
+    std::vector<std::vector<size_t>> plan_stages() const;
+    const NameTable& names() const;
+    template<class F>
+    void measure(const char*, const std::string&, F, size_t queued_updates);
+    template<class F>
+    void measure_process(size_t, F);
+    template<class F>
+    void measure_structure(const char*, const void*, F, size_t queued_updates = 0);
+    void run_processes(
+        const std::vector<std::vector<size_t>>& stages,
+        ThreadPool* pool,
+        size_t t
+    );
+
+public:
+    virtual ~Simulation() = default;
+
+    virtual void add_process(const process_t&);
+    virtual void add_process(const process_t&, const ProcessAccess&);
+    virtual void set_threads(size_t);
+    virtual void add_event(EventBase*, const std::vector<listener_t>&);
+    virtual void add_event(TargetedEvent*, const std::vector<listener_t>&);
+    virtual void add_variable(Variable*);
+    virtual void add_population(Population*);
+    virtual void update_and_resize(ThreadPool* pool, size_t t);
+    virtual void make_random_streams();
+    virtual void set_profiler(Profiler*);
+    virtual void set_tracer(Tracer*);
+    virtual void run(size_t timesteps);
+};
+
+inline void Simulation::add_process(const process_t& process) {
+    add_process(process, ProcessAccess());
+}
+
+//' @title add a process which has declared what it accesses
+//' @description declared processes may be run on other threads, so must not
+//' call the R API
+inline void Simulation::add_process(
+    const process_t& process,
+    const ProcessAccess& process_access
+) {
+    processes.push_back(process);
+    access.push_back(process_access);
+}
+
+inline void Simulation::set_threads(size_t n_threads) {
+    threads = std::max(n_threads, size_t(1));
+}
+
+//' @title split the processes into stages which can each run at once
+//' @description a process's stage is one after the latest stage of the
+//' earlier processes it conflicts with
+inline std::vector<std::vector<size_t>> Simulation::plan_stages() const {
+    auto stage = std::vector<size_t>(processes.size(), 0);
+    auto stages = std::vector<std::vector<size_t>>();
+    for (auto i = 0u; i < processes.size(); ++i) {
+        for (auto j = 0u; j < i; ++j) {
+            if (stage[j] + 1 > stage[i] && access[i].conflicts(access[j])) {
+                stage[i] = stage[j] + 1;
+            }
+        }
+        if (stage[i] == stages.size()) {
+            stages.push_back({});
+        }
+        stages[stage[i]].push_back(i);
+    }
+    return stages;
+}
+
+//' @title the names of processes and structures, from the profiler if there
+//' is one, otherwise from the tracer
+inline const NameTable& Simulation::names() const {
+    if (profiler != nullptr) {
+        return *profiler;
+    }
+    return *tracer;
+}
+
+//' @title run part of a timestep, measuring and tracing it
+template<class F>
+inline void Simulation::measure(
+    const char* phase,
+    const std::string& name,
+    F f,
+    size_t queued_updates
+) {
+    TraceScope scope(tracer, phase, name, timestep);
+    if (profiler == nullptr) {
+        f();
+        return;
+    }
+    profiler->measure(timestep, phase, name, f, queued_updates);
+}
+
+//' @title run a process, measuring it if there is a profiler or tracer
+template<class F>
+inline void Simulation::measure_process(size_t i, F f) {
+    if (profiler == nullptr && tracer == nullptr) {
+        f();
+        return;
+    }
+    measure("process", names().process_name(i), f, 0);
+}
+
+//' @title run a phase for a structure, measuring it if there is a profiler
+//' or tracer
+template<class F>
+inline void Simulation::measure_structure(
+    const char* phase,
+    const void* structure,
+    F f,
+    size_t queued_updates
+) {
+    if (profiler == nullptr && tracer == nullptr) {
+        f();
+        return;
+    }
+    measure(phase, names().structure_name(structure), f, queued_updates);
+}
+
+//' @title apply queued updates, then resizes, to every structure
+//' @description Each structure is only changed by one task, so running on a
+//' pool gives the same result as running one after another. Variables are
+//' updated in parallel, then populations are resized one at a time (each
+//' applying its plan to its structures in parallel), then the remaining
+//' events and variables are resized in parallel.
+//' @param pool a pool to run on, or nullptr
+//' @param t the timestep, which the profiler records
+inline void Simulation::update_and_resize(ThreadPool* pool, size_t t) {
+    timestep = t;
+    auto updates = std::vector<std::function<void ()>>();
+    for (auto variable : variables) {
+        updates.push_back([this, variable]() {
+            measure_structure(
+                "update",
+                variable,
+                [variable]() { variable->update(); },
+                variable->get_queue_size()
+            );
+        });
+    }
+    run_tasks(pool, updates);
+    for (auto population : populations) {
+        measure_structure("resize", population, [population, pool]() {
+            population->resize(pool);
+        });
+    }
+    auto resizes = std::vector<std::function<void ()>>();
+    for (auto event : targeted_events) {
+        resizes.push_back([this, event]() {
+            measure_structure("resize", event, [event]() { event->resize(); });
+        });
+    }
+    for (auto variable : variables) {
+        resizes.push_back([this, variable]() {
+            measure_structure("resize", variable, [variable]() { variable->resize(); });
+        });
+    }
+    run_tasks(pool, resizes);
+}
+
+//' @title run every process for a timestep, a stage at a time
+//' @description processes draw from their own random stream, if they have
+//' one, otherwise from the thread's. Without the native generator, processes
+//' would sample from R's generator, which may only be used on R's thread, so
+//' stages are run one process at a time. The changes made by declared
+//' processes are always staged, even when they run one at a time, so that a
+//' process which reads a structure it queues changes to sees the same state
+//' whatever the number of threads. Undeclared processes always run alone, so
+//' their changes are queued as they are made.
+inline void Simulation::run_processes(
+    const std::vector<std::vector<size_t>>& stages,
+    ThreadPool* pool,
+    size_t t
+) {
+    const auto run_process = [this, t](size_t i) {
+        RandomScope scope(streams.empty() ? nullptr : &streams[i]);
+        measure_process(i, [this, i, t]() { processes[i](t); });
+    };
+    const auto parallel = pool != nullptr && native_random();
+    for (const auto& stage : stages) {
+        if (!parallel || stage.size() == 1) {
+            for (auto i : stage) {
+                if (!access[i].declared) {
+                    run_process(i);
+                    continue;
+                }
+                auto buffer = staged_changes_t();
+                {
+                    StagingScope scope(buffer);
+                    run_process(i);
+                }
+                apply_staged_changes(buffer);
+            }
+            continue;
+        }
+        auto staged = std::vector<staged_changes_t>(stage.size());
+        auto tasks = std::vector<std::function<void ()>>();
+        for (auto k = 0u; k < stage.size(); ++k) {
+            const auto i = stage[k];
+            auto& buffer = staged[k];
+            tasks.push_back([&run_process, i, &buffer]() {
+                StagingScope scope(buffer);
+                run_process(i);
+            });
+        }
+        TraceScope scope(tracer, "loop", "parallel stage", t);
+        pool->run(tasks);
+        for (auto& buffer : staged) {
+            apply_staged_changes(buffer);
+        }
+    }
+}
+
+//' @title add an event and the listeners to call when it triggers
+//' @description listeners are called with the event's current timestep
+inline void Simulation::add_event(
+    EventBase* event,
+    const std::vector<listener_t>& listeners
+) {
+    events.push_back({ event, listeners });
+}
+
+//' @title add a targeted event, which is also resized on each timestep
+//' @description listeners are called with the event's current timestep and
+//' must get the current target from the event themselves
+inline void Simulation::add_event(
+    TargetedEvent* event,
+    const std::vector<listener_t>& listeners
+) {
+    add_event(static_cast<EventBase*>(event), listeners);
+    targeted_events.push_back(event);
+}
+
+inline void Simulation::add_variable(Variable* variable) {
+    variables.push_back(variable);
+}
+
+inline void Simulation::add_population(Population* population) {
+    populations.push_back(population);
+}
+
+//' @title give each process its own native random stream
+//' @description does nothing if the streams have been made or R's generator
+//' is used. Streams are made in process order, so making them for several
+//' simulations one after another gives each the same streams every time.
+inline void Simulation::make_random_streams() {
+    if (!streams.empty() || !native_random()) {
+        return;
+    }
+    for (auto i = 0u; i < processes.size(); ++i) {
+        streams.push_back(new_random_stream());
+    }
+}
+
+//' @title measure each part of each timestep with a profiler
+//' @param profiler_to_use the profiler, which must outlive the run, or
+//' nullptr to stop measuring
+inline void Simulation::set_profiler(Profiler* profiler_to_use) {
+    profiler = profiler_to_use;
+}
+
+//' @title record each part of each timestep with a tracer
+//' @description besides what a profiler measures, the tracer records each
+//' timestep and each phase of the loop
+//' @param tracer_to_use the tracer, which must outlive the run, or nullptr
+//' to stop tracing
+inline void Simulation::set_tracer(Tracer* tracer_to_use) {
+    tracer = tracer_to_use;
+}
+
+//' @title run the simulation
+//' @description interrupts from R are only checked for when not running as
+//' a task on a pool
+//' @param timesteps the number of timesteps to run
+inline void Simulation::run(size_t timesteps) {
+    const auto stages = plan_stages();
+    auto pool = std::unique_ptr<ThreadPool>();
+    if (threads > 1) {
+        pool.reset(new ThreadPool(threads));
+    }
+    make_random_streams();
+    for (auto t = 1u; t <= timesteps; ++t) {
+        if (!in_pool_task()) {
+            Rcpp::checkUserInterrupt();
+        }
+        timestep = t;
+        TraceScope timestep_scope(tracer, "loop", "timestep", t);
+        {
+            TraceScope scope(tracer, "loop", "processes", t);
+            run_processes(stages, pool.get(), t);
+        }
+        {
+            TraceScope scope(tracer, "loop", "listeners", t);
+            for (auto& event : events) {
+                if (event.second.empty() || !event.first->should_trigger()) {
+                    continue;
+                }
+                measure_structure("listener", event.first, [&event]() {
+                    for (auto& listener : event.second) {
+                        // a listener may clear the schedule for later listeners
+                        if (event.first->should_trigger()) {
+                            listener(event.first->get_time());
+                        }
+                    }
+                });
+            }
+        }
+        {
+            TraceScope scope(tracer, "loop", "update and resize", t);
+            update_and_resize(pool.get(), t);
+        }
+        TraceScope scope(tracer, "loop", "tick", t);
+        for (auto& event : events) {
+            event.first->tick();
+        }
+    }
+}
+
+#endif /* INST_INCLUDE_SIMULATION_H_ */
@@ -0,0 +1,63 @@
+/*
+ * Staging.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_STAGING_H_
+#define INST_INCLUDE_STAGING_H_
+
+#include <functional>
+#include <vector>
+
+//' @title changes to structures which are staged until they can be applied
+//' @description Processes running on other threads stage their queued
+//' updates, extensions, shrinks and schedules here instead of changing the
+//' structures. Each running process has its own buffer, so staging a change
+//' needs no locks. Once every process in a stage has finished, the buffers
+//' are applied on the calling thread in the order the processes were added,
+//' so structures end up with the same queues as if the processes had run
+//' one after another.
+using staged_changes_t = std::vector<std::function<void ()>>;
+
+//' @title the buffer changes made on this thread are staged in, or nullptr
+//' if changes should be applied immediately
+//' @description structures check this at the start of each method which
+//' changes them and, if there is a buffer, stage a function which calls the
+//' method again with copies of its arguments. The arguments are only copied
+//' once the buffer has been found, so changes which are applied immediately
+//' cost no more than before changes could be staged.
+inline staged_changes_t*& staging_buffer() {
+    static thread_local staged_changes_t* buffer = nullptr;
+    return buffer;
+}
+
+//' @title stage changes made on this thread in a buffer while in scope
+class StagingScope {
+    staged_changes_t* previous;
+
+public:
+    StagingScope(staged_changes_t& buffer);
+    StagingScope(const StagingScope&) = delete;
+    StagingScope& operator=(const StagingScope&) = delete;
+    virtual ~StagingScope();
+};
+
+inline StagingScope::StagingScope(staged_changes_t& buffer)
+    : previous(staging_buffer()) {
+    staging_buffer() = &buffer;
+}
+
+inline StagingScope::~StagingScope() {
+    staging_buffer() = previous;
+}
+
+//' @title apply staged changes in the order they were staged
+inline void apply_staged_changes(staged_changes_t& changes) {
+    for (auto& change : changes) {
+        change();
+    }
+    changes.clear();
+}
+
+#endif /* INST_INCLUDE_STAGING_H_ */
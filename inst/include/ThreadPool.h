@@ -0,0 +1,211 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_THREAD_POOL_H_
+#define INST_INCLUDE_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//' @title is this thread running a task from a pool?
+//' @description pools are not re-entrant, so code which may run inside a task
+//' checks this before running work on a pool of its own
+inline bool& in_pool_task() {
+    static thread_local bool running = false;
+    return running;
+}
+
+//' @title a work-stealing pool of threads
+//' @description `run` shares a batch of tasks between the workers' queues
+//' and blocks until they have all finished. The calling thread is one of the
+//' workers. Each worker takes tasks from the back of its own queue and, once
+//' that is empty, steals from the front of the others'. Tasks must not call
+//' the R API. If any tasks throw, the exception from the first of them (in
+//' the order they were given) is rethrown by `run` once every task has
+//' finished.
+//' It contains the following data members:
+//'     * threads: the workers other than the calling thread
+//'     * queues: each worker's queue of task indices and tasks
+//'     * errors: the exception thrown by each task in the current batch
+//'     * remaining: the number of unfinished tasks in the current batch
+//'     * generation: the number of batches so far, which wakes the workers
+class ThreadPool {
+
+    using task_t = std::function<void ()>;
+
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<std::pair<size_t, task_t>> tasks;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::exception_ptr> errors;
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    size_t generation = 0;
+    bool stopping = false;
+
+    bool take(size_t worker, std::pair<size_t, task_t>& task);
+    void work(size_t worker);
+    void loop(size_t worker);
+
+public:
+    ThreadPool(size_t n_threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    virtual ~ThreadPool();
+
+    virtual size_t size() const;
+    virtual void run(const std::vector<task_t>& tasks);
+};
+
+//' @title start a pool
+//' @param n_threads the number of workers, including the calling thread
+inline ThreadPool::ThreadPool(size_t n_threads) {
+    if (n_threads == 0) {
+        n_threads = 1;
+    }
+    for (auto i = 0u; i < n_threads; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (auto i = 1u; i < n_threads; ++i) {
+        threads.emplace_back(&ThreadPool::loop, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+//' @title the number of workers, including the calling thread
+inline size_t ThreadPool::size() const {
+    return queues.size();
+}
+
+//' @title take a task from a worker's own queue, or steal one
+//' @return false if every queue is empty
+inline bool ThreadPool::take(size_t worker, std::pair<size_t, task_t>& task) {
+    {
+        auto& own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (auto i = 1u; i < queues.size(); ++i) {
+        auto& other = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(other.lock);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+//' @title run tasks until every queue is empty
+inline void ThreadPool::work(size_t worker) {
+    auto task = std::pair<size_t, task_t>();
+    while (take(worker, task)) {
+        const auto outer = in_pool_task();
+        in_pool_task() = true;
+        try {
+            task.second();
+        } catch (...) {
+            errors[task.first] = std::current_exception();
+        }
+        in_pool_task() = outer;
+        if (--remaining == 0) {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+            }
+            finished.notify_all();
+        }
+    }
+}
+
+//' @title wait for each batch and help to run it
+inline void ThreadPool::loop(size_t worker) {
+    auto seen = size_t(0);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(mutex);
+            started.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        work(worker);
+    }
+}
+
+//' @title run a batch of tasks and wait for them all to finish
+inline void ThreadPool::run(const std::vector<task_t>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        errors.assign(tasks.size(), nullptr);
+        remaining = tasks.size();
+        for (auto i = 0u; i < tasks.size(); ++i) {
+            auto& queue = *queues[i % queues.size()];
+            std::lock_guard<std::mutex> queue_guard(queue.lock);
+            queue.tasks.push_back({ i, tasks[i] });
+        }
+        ++generation;
+    }
+    started.notify_all();
+    work(0);
+    {
+        std::unique_lock<std::mutex> guard(mutex);
+        finished.wait(guard, [&] { return remaining == 0; });
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+//' @title run tasks on a pool, or one after another if there is no pool
+//' @param pool the pool, or nullptr
+//' @param tasks the tasks to run
+inline void run_tasks(
+    ThreadPool* pool,
+    const std::vector<std::function<void ()>>& tasks
+) {
+    if (pool == nullptr || tasks.size() < 2) {
+        for (const auto& task : tasks) {
+            task();
+        }
+        return;
+    }
+    pool->run(tasks);
+}
+
+#endif /* INST_INCLUDE_THREAD_POOL_H_ */
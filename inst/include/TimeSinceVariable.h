@@ -0,0 +1,229 @@
+/*
+ * TimeSinceVariable.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_TIME_SINCE_VARIABLE_H_
+#define INST_INCLUDE_TIME_SINCE_VARIABLE_H_
+
+#include "DoubleVariable.h"
+
+//' @title a view of the time since a vector of timestamps
+//' @description the time the view was created at is fixed, so the view only
+//' needs to be detached when the timestamps change
+class TimeSinceView : public ValuesView<double> {
+    const std::vector<double>* source;
+    std::vector<double> snapshot;
+    const double now;
+
+public:
+    TimeSinceView(const std::vector<double>& source, const double now);
+    virtual ~TimeSinceView() = default;
+    virtual size_t size() const override;
+    virtual double at(size_t) const override;
+    virtual const double* data() const override;
+    virtual void detach() override;
+};
+
+inline TimeSinceView::TimeSinceView(
+    const std::vector<double>& source,
+    const double now
+) : source(&source), now(now) {}
+
+inline size_t TimeSinceView::size() const {
+    return source->size();
+}
+
+inline double TimeSinceView::at(size_t i) const {
+    return now - (*source)[i];
+}
+
+inline const double* TimeSinceView::data() const {
+    return nullptr;
+}
+
+inline void TimeSinceView::detach() {
+    if (source != &snapshot) {
+        snapshot = *source;
+        source = &snapshot;
+    }
+}
+
+//' @title a variable object for the time elapsed since some event
+//' @description This class stores the time at which each individual's value
+//' was zero rather than the value itself. Values are computed relative to the
+//' current time when they are read, so every value increases by dt on each
+//' call to update without the variable having to be modified. It inherits
+//' from DoubleVariable.
+//' It contains the following data members:
+//'     * values: a vector of timestamps
+//'     * dt: the time which passes on each call to update
+//'     * timestep: the number of calls to update so far
+class TimeSinceVariable : public DoubleVariable {
+
+    const double dt;
+    size_t timestep = 0;
+
+    std::vector<double> to_timestamps(const std::vector<double>&) const;
+    std::vector<double> to_elapsed(std::vector<double>) const;
+
+public:
+    TimeSinceVariable(const std::vector<double>& values, const double dt);
+    virtual ~TimeSinceVariable() = default;
+    virtual Variable* clone() const override;
+    virtual void save(CheckpointWriter&) const override;
+    virtual void load(CheckpointReader&) override;
+
+    virtual double now() const;
+
+    virtual std::vector<double> get_values() const override;
+    virtual std::vector<double> get_values(const individual_index_t& index) const override;
+    virtual std::vector<double> get_values(const std::vector<size_t>& index) const override;
+    virtual std::shared_ptr<ValuesView<double>> get_values_view() const override;
+
+    virtual individual_index_t get_index_of_range(const double a, const double b) const override;
+    virtual size_t get_size_of_range(const double a, const double b) const override;
+
+    virtual void queue_update(const std::vector<double>& values, const std::vector<size_t>& index) override;
+    virtual void queue_extend(const std::vector<double>&) override;
+
+    virtual void update() override;
+};
+
+inline TimeSinceVariable::TimeSinceVariable(
+    const std::vector<double>& values,
+    const double dt
+) : DoubleVariable(values), dt(dt) {
+    if (!(dt > 0)) {
+        Rcpp::stop("dt must be positive for TimeSinceVariable");
+    }
+    this->values = to_timestamps(values);
+}
+
+inline Variable* TimeSinceVariable::clone() const {
+    return new TimeSinceVariable(*this);
+}
+
+//' @title write the variable's state, values are saved as timestamps
+inline void TimeSinceVariable::save(CheckpointWriter& out) const {
+    DoubleVariable::save(out);
+    out.write_tag("TimeSinceVariable");
+    out.write(dt);
+    out.write(static_cast<uint64_t>(timestep));
+}
+
+inline void TimeSinceVariable::load(CheckpointReader& in) {
+    DoubleVariable::load(in);
+    in.expect_tag("TimeSinceVariable");
+    auto saved_dt = 0.;
+    in.read(saved_dt);
+    if (saved_dt != dt) {
+        Rcpp::stop("checkpoint has a different dt to the variable");
+    }
+    auto saved_timestep = uint64_t(0);
+    in.read(saved_timestep);
+    timestep = saved_timestep;
+}
+
+//' @title the current time
+//' @description calculated from the number of updates so that errors do not
+//' accumulate
+inline double TimeSinceVariable::now() const {
+    return timestep * dt;
+}
+
+//' @title convert values at the current time into timestamps
+inline std::vector<double> TimeSinceVariable::to_timestamps(
+    const std::vector<double>& elapsed
+) const {
+    auto timestamps = std::vector<double>(elapsed.size());
+    const auto t = now();
+    for (auto i = 0u; i < elapsed.size(); ++i) {
+        timestamps[i] = t - elapsed[i];
+    }
+    return timestamps;
+}
+
+//' @title convert timestamps into values at the current time
+inline std::vector<double> TimeSinceVariable::to_elapsed(
+    std::vector<double> timestamps
+) const {
+    const auto t = now();
+    for (auto& x : timestamps) {
+        x = t - x;
+    }
+    return timestamps;
+}
+
+//' @title get all values
+inline std::vector<double> TimeSinceVariable::get_values() const {
+    return to_elapsed(values.read());
+}
+
+//' @title get values at index given by a bitset
+inline std::vector<double> TimeSinceVariable::get_values(
+    const individual_index_t& index
+) const {
+    return to_elapsed(DoubleVariable::get_values(index));
+}
+
+//' @title get values at index given by a vector
+inline std::vector<double> TimeSinceVariable::get_values(
+    const std::vector<size_t>& index
+) const {
+    return to_elapsed(DoubleVariable::get_values(index));
+}
+
+//' @title get a read-only view of all values at the current time
+inline std::shared_ptr<ValuesView<double>> TimeSinceVariable::get_values_view() const {
+    auto view = std::make_shared<TimeSinceView>(values.read(), now());
+    views.add(view);
+    return view;
+}
+
+//' @title return bitset giving index of individuals whose value is in some range [a,b]
+inline individual_index_t TimeSinceVariable::get_index_of_range(
+    const double a, const double b
+) const {
+    const auto t = now();
+    return vector_index_where(values.read(), tombstones, [&](const double x) -> bool {
+        return in_range<double>{ a, b }(t - x);
+    });
+}
+
+//' @title return number of individuals whose value is in some range [a,b]
+inline size_t TimeSinceVariable::get_size_of_range(
+    const double a, const double b
+) const {
+    const auto t = now();
+    return vector_count_where(values.read(), tombstones, [&](const double x) -> bool {
+        return in_range<double>{ a, b }(t - x);
+    });
+}
+
+//' @title queue a state update for some subset of individuals
+//' @description values are the time since at the current time
+inline void TimeSinceVariable::queue_update(
+    const std::vector<double>& values,
+    const std::vector<size_t>& index
+) {
+    DoubleVariable::queue_update(to_timestamps(values), index);
+}
+
+//' @title queue new values to add to the variable
+//' @description values are the time since at the current time
+inline void TimeSinceVariable::queue_extend(
+    const std::vector<double>& new_values
+) {
+    DoubleVariable::queue_extend(to_timestamps(new_values));
+}
+
+//' @title apply all queued state updates and advance the time by dt
+inline void TimeSinceVariable::update() {
+    DoubleVariable::update();
+    ++timestep;
+    ++version;
+}
+
+#endif /* INST_INCLUDE_TIME_SINCE_VARIABLE_H_ */
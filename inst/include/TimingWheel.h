@@ -0,0 +1,507 @@
+/*
+ * TimingWheel.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_TIMING_WHEEL_H_
+#define INST_INCLUDE_TIMING_WHEEL_H_
+
+#include "ResizePlan.h"
+#include "common_types.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+//' @title remove individuals from a sorted vector and renumber the rest
+//' @param values sorted, distinct individuals
+//' @param removed sorted, distinct individuals to remove
+inline void shrink_sorted(
+    std::vector<size_t>& values,
+    const std::vector<size_t>& removed
+) {
+    if (removed.empty()) {
+        return;
+    }
+    auto removal_it = removed.cbegin();
+    size_t n_shifts = 0;
+    auto write = values.begin();
+    for (auto read = values.cbegin(); read != values.cend(); ++read) {
+        while (removal_it != removed.cend() && *read > *removal_it) {
+            ++removal_it;
+            ++n_shifts;
+        }
+        if (removal_it == removed.cend() || *read != *removal_it) {
+            *write = *read - n_shifts;
+            ++write;
+        }
+    }
+    values.erase(write, values.end());
+}
+
+//' @title the individuals scheduled for one timestep
+//' @description Individuals are stored as a vector while there are few of
+//' them and as a bitset once a vector would take more memory than a bitset
+//' (more than one individual per 64). The vector is kept sorted as it is
+//' changed, so that reads do not change the slot and can be made from many
+//' threads. Individuals are usually scheduled in order, which appends to the
+//' vector, and the vector is short, so an insert out of order is cheap.
+//' It contains the following data members:
+//'     * max_size: the size of the population
+//'     * dense: whether individuals are stored in the bitset
+//'     * sparse: the individuals, sorted and distinct, if not dense
+//'     * bitset: the individuals, if dense
+class ScheduleSlot {
+
+    size_t max_size;
+    bool dense = false;
+    std::vector<size_t> sparse;
+    individual_index_t bitset = individual_index_t(0);
+
+    size_t dense_threshold() const;
+    void to_dense();
+    void check_density();
+
+public:
+    ScheduleSlot(size_t max_size);
+    virtual ~ScheduleSlot() = default;
+
+    virtual void insert(size_t);
+    virtual void insert(const individual_index_t&);
+    virtual void erase(const individual_index_t&);
+    virtual void erase(const std::vector<size_t>&);
+    virtual void erase(size_t);
+
+    virtual bool empty() const;
+    virtual size_t size() const;
+    virtual bool contains(size_t) const;
+    virtual individual_index_t to_bitset() const;
+    virtual void add_to(individual_index_t&) const;
+    template<class F>
+    void for_each(F f) const;
+
+    virtual void resize(const std::vector<size_t>& removed, size_t new_max_size);
+    virtual void allocate(const ResizePlan&);
+    virtual void compact(const ResizePlan&);
+};
+
+inline ScheduleSlot::ScheduleSlot(size_t max_size) : max_size(max_size) {}
+
+//' @title the number of individuals above which a bitset is smaller
+inline size_t ScheduleSlot::dense_threshold() const {
+    return max_size / 64 + 1;
+}
+
+inline void ScheduleSlot::to_dense() {
+    bitset = individual_index_t(max_size);
+    bitset.insert(sparse.cbegin(), sparse.cend());
+    sparse = std::vector<size_t>();
+    dense = true;
+}
+
+//' @title switch between a vector and a bitset if the other is smaller
+//' @description a bitset is only turned back into a vector once it is well
+//' under the threshold, so that a slot does not switch back and forth
+inline void ScheduleSlot::check_density() {
+    if (dense) {
+        if (bitset.size() < dense_threshold() / 2) {
+            sparse.assign(bitset.cbegin(), bitset.cend());
+            bitset = individual_index_t(0);
+            dense = false;
+        }
+    } else if (sparse.size() > dense_threshold()) {
+        to_dense();
+    }
+}
+
+inline void ScheduleSlot::insert(size_t i) {
+    if (dense) {
+        bitset.insert(i);
+        return;
+    }
+    if (sparse.empty() || i > sparse.back()) {
+        sparse.push_back(i);
+    } else {
+        const auto it = std::lower_bound(sparse.begin(), sparse.end(), i);
+        if (*it == i) {
+            return;
+        }
+        sparse.insert(it, i);
+    }
+    check_density();
+}
+
+inline void ScheduleSlot::insert(const individual_index_t& target) {
+    if (!dense && sparse.size() + target.size() > dense_threshold()) {
+        to_dense();
+    }
+    if (dense) {
+        bitset |= target;
+        return;
+    }
+    for (auto i : target) {
+        insert(i);
+    }
+}
+
+inline void ScheduleSlot::erase(const individual_index_t& target) {
+    if (dense) {
+        bitset &= !target;
+    } else {
+        sparse.erase(
+            std::remove_if(sparse.begin(), sparse.end(), [&](size_t i) {
+                return target.find(i) != target.cend();
+            }),
+            sparse.end()
+        );
+    }
+    check_density();
+}
+
+//' @title remove a sorted vector of individuals
+//' @description only the individuals being removed are visited if the slot is
+//' dense
+inline void ScheduleSlot::erase(const std::vector<size_t>& sorted_target) {
+    if (dense) {
+        for (auto i : sorted_target) {
+            bitset.erase(i);
+        }
+    } else {
+        sparse.erase(
+            std::remove_if(sparse.begin(), sparse.end(), [&](size_t i) {
+                return std::binary_search(
+                    sorted_target.cbegin(),
+                    sorted_target.cend(),
+                    i
+                );
+            }),
+            sparse.end()
+        );
+    }
+    check_density();
+}
+
+inline void ScheduleSlot::erase(size_t i) {
+    if (dense) {
+        bitset.erase(i);
+        check_density();
+        return;
+    }
+    sparse.erase(std::remove(sparse.begin(), sparse.end(), i), sparse.end());
+}
+
+inline bool ScheduleSlot::empty() const {
+    return dense ? bitset.empty() : sparse.empty();
+}
+
+inline size_t ScheduleSlot::size() const {
+    if (dense) {
+        return bitset.size();
+    }
+    return sparse.size();
+}
+
+inline bool ScheduleSlot::contains(size_t i) const {
+    if (dense) {
+        return bitset.find(i) != bitset.cend();
+    }
+    return std::binary_search(sparse.cbegin(), sparse.cend(), i);
+}
+
+inline individual_index_t ScheduleSlot::to_bitset() const {
+    if (dense) {
+        return bitset;
+    }
+    return individual_index_t(max_size, sparse.cbegin(), sparse.cend());
+}
+
+//' @title add the slot's individuals to a bitset
+inline void ScheduleSlot::add_to(individual_index_t& result) const {
+    if (dense) {
+        result |= bitset;
+    } else {
+        result.insert(sparse.cbegin(), sparse.cend());
+    }
+}
+
+//' @title apply a function to each individual in the slot, in order
+template<class F>
+inline void ScheduleSlot::for_each(F f) const {
+    if (dense) {
+        for (auto i : bitset) {
+            f(i);
+        }
+    } else {
+        for (auto i : sparse) {
+            f(i);
+        }
+    }
+}
+
+//' @title remove individuals, renumbering the rest, and grow to a new size
+//' @param removed sorted, distinct individuals to remove
+//' @param new_max_size the size of the population after resizing
+inline void ScheduleSlot::resize(
+    const std::vector<size_t>& removed,
+    size_t new_max_size
+) {
+    if (dense) {
+        if (!removed.empty()) {
+            bitset.shrink(removed);
+        }
+        bitset.extend(new_max_size - bitset.max_size());
+    } else {
+        shrink_sorted(sparse, removed);
+    }
+    max_size = new_max_size;
+    check_density();
+}
+
+//' @title apply the first two steps of a resize plan, see ResizePlan
+inline void ScheduleSlot::allocate(const ResizePlan& plan) {
+    if (plan.tombstones == nullptr) {
+        resize(plan.removed_vector, plan.allocated_size);
+        return;
+    }
+    if (dense) {
+        bitset &= !plan.removed;
+        bitset.extend(plan.allocated_size - bitset.max_size());
+    } else {
+        sparse.erase(
+            std::remove_if(sparse.begin(), sparse.end(), [&](size_t i) {
+                return plan.removed.find(i) != plan.removed.cend();
+            }),
+            sparse.end()
+        );
+    }
+    max_size = plan.allocated_size;
+}
+
+//' @title apply the last step of a resize plan, see ResizePlan
+inline void ScheduleSlot::compact(const ResizePlan& plan) {
+    if (!plan.compacted_vector.empty()) {
+        if (dense) {
+            bitset.shrink(plan.compacted_vector);
+        } else {
+            shrink_sorted(sparse, plan.compacted_vector);
+        }
+    }
+    max_size = plan.final_size();
+    check_density();
+}
+
+//' @title a calendar queue of scheduled individuals
+//' @description Timesteps in [now, now + wheel_size) each have a slot in a
+//' ring buffer, so finding the slot for a timestep is O(1). Timesteps further
+//' ahead are kept in an ordered map and moved into the ring as time advances.
+//' A timestep is pending once a slot has been made for it, even if every
+//' individual in it is later cleared, as with a map of timesteps.
+//' It contains the following data members:
+//'     * max_size: the size of the population
+//'     * now: the current timestep
+//'     * wheel: the slot for timestep t is wheel[t % wheel_size]
+//'     * pending: whether each slot in the wheel has been made
+//'     * overflow: the slots for timesteps beyond the wheel
+class TimingWheel {
+
+    static constexpr size_t wheel_size = 256;
+    size_t max_size;
+    size_t now;
+    std::vector<ScheduleSlot> wheel;
+    std::vector<bool> pending;
+    std::map<size_t, ScheduleSlot> overflow;
+
+public:
+    TimingWheel(size_t max_size, size_t now);
+    virtual ~TimingWheel() = default;
+
+    virtual ScheduleSlot& at(size_t timestep);
+    virtual const ScheduleSlot* find(size_t timestep) const;
+    virtual void advance();
+    virtual void resize(size_t max_size);
+
+    template<class F>
+    void for_each(F f);
+    template<class F>
+    void for_each(F f) const;
+};
+
+inline TimingWheel::TimingWheel(size_t max_size, size_t now)
+    : max_size(max_size),
+      now(now),
+      wheel(wheel_size, ScheduleSlot(max_size)),
+      pending(wheel_size, false) {}
+
+//' @title get the slot for a timestep, which must not be in the past
+inline ScheduleSlot& TimingWheel::at(size_t timestep) {
+    if (timestep < now) {
+        Rcpp::stop("cannot schedule an event in the past");
+    }
+    if (timestep < now + wheel_size) {
+        const auto i = timestep % wheel_size;
+        if (!pending[i]) {
+            wheel[i] = ScheduleSlot(max_size);
+            pending[i] = true;
+        }
+        return wheel[i];
+    }
+    auto it = overflow.find(timestep);
+    if (it == overflow.end()) {
+        it = overflow.insert({ timestep, ScheduleSlot(max_size) }).first;
+    }
+    return it->second;
+}
+
+//' @title get the slot for a timestep, or nullptr if it is not pending
+inline const ScheduleSlot* TimingWheel::find(size_t timestep) const {
+    if (timestep < now) {
+        return nullptr;
+    }
+    if (timestep < now + wheel_size) {
+        if (!pending[timestep % wheel_size]) {
+            return nullptr;
+        }
+        return &wheel[timestep % wheel_size];
+    }
+    const auto it = overflow.find(timestep);
+    if (it == overflow.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+//' @title clear the current timestep and move on to the next
+inline void TimingWheel::advance() {
+    wheel[now % wheel_size] = ScheduleSlot(max_size);
+    pending[now % wheel_size] = false;
+    ++now;
+    // the slot which has just been freed now holds now + wheel_size - 1
+    const auto it = overflow.find(now + wheel_size - 1);
+    if (it != overflow.end()) {
+        wheel[it->first % wheel_size] = std::move(it->second);
+        pending[it->first % wheel_size] = true;
+        overflow.erase(it);
+    }
+}
+
+//' @title record the population size that new slots are created with
+inline void TimingWheel::resize(size_t new_max_size) {
+    max_size = new_max_size;
+}
+
+//' @title apply a function to every pending slot and its timestep
+template<class F>
+inline void TimingWheel::for_each(F f) {
+    for (auto t = now; t < now + wheel_size; ++t) {
+        if (pending[t % wheel_size]) {
+            f(t, wheel[t % wheel_size]);
+        }
+    }
+    for (auto& entry : overflow) {
+        f(entry.first, entry.second);
+    }
+}
+
+template<class F>
+inline void TimingWheel::for_each(F f) const {
+    for (auto t = now; t < now + wheel_size; ++t) {
+        if (pending[t % wheel_size]) {
+            f(t, wheel[t % wheel_size]);
+        }
+    }
+    for (const auto& entry : overflow) {
+        f(entry.first, entry.second);
+    }
+}
+
+//' @title the timesteps each individual is scheduled for
+//' @description A reverse index of a TimingWheel, so that an individual's
+//' slots can be found without visiting every slot, and a union of every
+//' scheduled individual which is kept up to date as individuals are
+//' scheduled, fired and cleared. Only scheduled individuals have an entry.
+//' It contains the following data members:
+//'     * timesteps: the timesteps each scheduled individual is scheduled for
+//'     * scheduled: every scheduled individual
+class ScheduleIndex {
+
+    std::unordered_map<size_t, std::vector<size_t>> timesteps;
+    individual_index_t scheduled;
+
+public:
+    ScheduleIndex(size_t max_size);
+    virtual ~ScheduleIndex() = default;
+
+    virtual void add(size_t individual, size_t timestep);
+    virtual std::vector<size_t> remove(size_t individual);
+    virtual void fire(size_t timestep, const ScheduleSlot&);
+    virtual void rebuild(const TimingWheel&, size_t max_size);
+    virtual const individual_index_t& get_scheduled() const;
+};
+
+inline ScheduleIndex::ScheduleIndex(size_t max_size)
+    : scheduled(individual_index_t(max_size)) {}
+
+//' @title record that an individual is scheduled for a timestep
+inline void ScheduleIndex::add(size_t individual, size_t timestep) {
+    auto& individual_timesteps = timesteps[individual];
+    if (std::find(
+        individual_timesteps.cbegin(),
+        individual_timesteps.cend(),
+        timestep
+    ) == individual_timesteps.cend()) {
+        individual_timesteps.push_back(timestep);
+    }
+    scheduled.insert(individual);
+}
+
+//' @title forget an individual
+//' @return the timesteps the individual was scheduled for
+inline std::vector<size_t> ScheduleIndex::remove(size_t individual) {
+    const auto it = timesteps.find(individual);
+    if (it == timesteps.end()) {
+        return std::vector<size_t>();
+    }
+    auto removed = std::move(it->second);
+    timesteps.erase(it);
+    scheduled.erase(individual);
+    return removed;
+}
+
+//' @title forget a timestep for the individuals in its slot, once it has fired
+inline void ScheduleIndex::fire(size_t timestep, const ScheduleSlot& slot) {
+    slot.for_each([&](size_t individual) {
+        const auto it = timesteps.find(individual);
+        if (it == timesteps.end()) {
+            return;
+        }
+        auto& individual_timesteps = it->second;
+        individual_timesteps.erase(std::remove(
+            individual_timesteps.begin(),
+            individual_timesteps.end(),
+            timestep
+        ), individual_timesteps.end());
+        if (individual_timesteps.empty()) {
+            timesteps.erase(it);
+            scheduled.erase(individual);
+        }
+    });
+}
+
+//' @title index every slot in a wheel, e.g. after its individuals have been
+//' renumbered by a resize
+inline void ScheduleIndex::rebuild(const TimingWheel& wheel, size_t max_size) {
+    timesteps.clear();
+    scheduled = individual_index_t(max_size);
+    wheel.for_each([&](size_t timestep, const ScheduleSlot& slot) {
+        slot.for_each([&](size_t individual) {
+            add(individual, timestep);
+        });
+    });
+}
+
+inline const individual_index_t& ScheduleIndex::get_scheduled() const {
+    return scheduled;
+}
+
+#endif /* INST_INCLUDE_TIMING_WHEEL_H_ */
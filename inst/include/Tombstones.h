@@ -0,0 +1,124 @@
+/*
+ * Tombstones.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_TOMBSTONES_H_
+#define INST_INCLUDE_TOMBSTONES_H_
+
+#include "common_types.h"
+#include "Checkpoint.h"
+#include <Rcpp.h>
+
+//' @title free slots left by removed individuals
+//' @description When tombstones are enabled, shrinking a structure does not
+//' renumber the individuals after those removed. The removed individuals'
+//' slots become free (tombstones), they are masked out of queries and are
+//' reused by new individuals. Free slots are only compacted away once they
+//' make up more than `threshold` of the slots.
+//'
+//' Slots are allocated deterministically, lowest free slot first and then by
+//' appending, so structures which are resized with the same individuals always
+//' agree on where each individual is.
+//' It contains the following data members:
+//'     * threshold: the fraction of free slots which triggers compaction, or a
+//'     negative number if tombstones are disabled
+//'     * free: the free slots
+class Tombstones {
+
+    double threshold = -1;
+    individual_index_t free = individual_index_t(0);
+
+public:
+    Tombstones() = default;
+    virtual ~Tombstones() = default;
+
+    virtual void enable(const double threshold, const size_t size);
+    virtual bool enabled() const;
+    virtual const individual_index_t& get_free() const;
+    virtual size_t size() const;
+
+    virtual std::vector<size_t> allocate(const individual_index_t& removed, const size_t n);
+    virtual bool should_compact() const;
+    virtual void compacted();
+
+    virtual void save(CheckpointWriter&) const;
+    virtual void load(CheckpointReader&);
+    virtual bool consistent(size_t size) const;
+};
+
+//' @title start keeping tombstones for a structure of `size` slots
+inline void Tombstones::enable(const double threshold, const size_t size) {
+    if (!(threshold >= 0 && threshold <= 1)) {
+        Rcpp::stop("tombstone threshold must be between 0 and 1");
+    }
+    this->threshold = threshold;
+    free = individual_index_t(size);
+}
+
+inline bool Tombstones::enabled() const {
+    return threshold >= 0;
+}
+
+inline const individual_index_t& Tombstones::get_free() const {
+    return free;
+}
+
+//' @title the number of slots, free or not
+inline size_t Tombstones::size() const {
+    return free.max_size();
+}
+
+//' @title free the slots of removed individuals and allocate slots for new ones
+//' @param removed the individuals to remove
+//' @param n the number of new individuals
+//' @return the slots for the new individuals, in order
+inline std::vector<size_t> Tombstones::allocate(
+    const individual_index_t& removed,
+    const size_t n
+) {
+    free |= removed;
+    auto slots = std::vector<size_t>();
+    slots.reserve(n);
+    for (auto it = free.cbegin(); slots.size() < n && it != free.cend(); ++it) {
+        slots.push_back(*it);
+    }
+    for (auto slot : slots) {
+        free.erase(slot);
+    }
+    const auto first_appended = free.max_size();
+    const auto n_appended = n - slots.size();
+    for (auto i = 0u; i < n_appended; ++i) {
+        slots.push_back(first_appended + i);
+    }
+    free.extend(n_appended);
+    return slots;
+}
+
+//' @title are there enough free slots that they should be compacted away?
+inline bool Tombstones::should_compact() const {
+    return free.size() > 0 && free.size() > threshold * free.max_size();
+}
+
+//' @title record that the free slots have been compacted away
+inline void Tombstones::compacted() {
+    free.reset(free.max_size() - free.size());
+}
+
+inline void Tombstones::save(CheckpointWriter& out) const {
+    out.write(threshold);
+    out.write(free);
+}
+
+inline void Tombstones::load(CheckpointReader& in) {
+    in.read(threshold);
+    in.read(free);
+}
+
+//' @title do loaded tombstones fit a structure of `size` slots?
+inline bool Tombstones::consistent(size_t size) const {
+    return !enabled() || (threshold <= 1 && free.max_size() == size);
+}
+
+#endif /* INST_INCLUDE_TOMBSTONES_H_ */
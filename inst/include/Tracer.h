@@ -0,0 +1,229 @@
+/*
+ * Tracer.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_TRACER_H_
+#define INST_INCLUDE_TRACER_H_
+
+#include "NameTable.h"
+#include <Rcpp.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//' @title the beginning or end of a traced scope
+//' It contains the following data members:
+//'     * begin: whether the scope begins or ends here
+//'     * category: the kind of scope, e.g. "process" or "loop"
+//'     * name: what the scope runs, empty for ends
+//'     * timestep: the timestep
+//'     * microseconds: the time since the tracer was made
+struct TraceEvent {
+    bool begin;
+    const char* category;
+    std::string name;
+    size_t timestep;
+    double microseconds;
+};
+
+//' @title the events traced on one thread
+//' It contains the following data members:
+//'     * thread: the thread's number, see trace_thread
+//'     * events: the events, in the order they happened
+struct TraceBuffer {
+    size_t thread;
+    std::vector<TraceEvent> events;
+};
+
+//' @title a number for the calling thread, counted from zero in the order
+//' threads first trace
+inline size_t trace_thread() {
+    static std::atomic<size_t> next(0);
+    static thread_local size_t thread = next++;
+    return thread;
+}
+
+//' @title records a timeline of a simulation in the Chrome trace format
+//' @description Scopes are traced as begin and end events, which `write`
+//' saves as a JSON file that Perfetto (ui.perfetto.dev) and chrome://tracing
+//' show as a timeline with a row for each thread. Each thread appends to its
+//' own buffer, which it finds through a thread-local cache, so tracing on a
+//' pool only takes the lock the first time each thread traces. The buffers
+//' must not be written while a simulation is running.
+//' It contains the following data members:
+//'     * id: a number for this tracer, so that threads can tell whether
+//'     their cached buffer belongs to it
+//'     * start: when the tracer was made
+//'     * buffers: a buffer for each thread which has traced
+//'     * lock: guards buffers
+class Tracer : public NameTable {
+    const size_t id;
+    const std::chrono::steady_clock::time_point start;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    std::mutex lock;
+
+    static size_t next_id();
+    TraceBuffer& thread_buffer();
+    double now() const;
+
+public:
+    Tracer();
+    virtual ~Tracer() = default;
+
+    virtual void begin(const char* category, const std::string& name, size_t timestep);
+    virtual void end();
+    virtual size_t size() const;
+    virtual void write(const std::string& path) const;
+};
+
+inline size_t Tracer::next_id() {
+    static std::atomic<size_t> next(1);
+    return next++;
+}
+
+inline Tracer::Tracer() : id(next_id()), start(std::chrono::steady_clock::now()) {}
+
+//' @title the calling thread's buffer
+//' @description the cache is keyed by tracer id rather than address, so a
+//' new tracer made where an old one was is not given its buffer
+inline TraceBuffer& Tracer::thread_buffer() {
+    static thread_local size_t cached_id = 0;
+    static thread_local TraceBuffer* cached = nullptr;
+    if (cached_id != id) {
+        std::lock_guard<std::mutex> guard(lock);
+        buffers.emplace_back(new TraceBuffer{ trace_thread(), {} });
+        cached = buffers.back().get();
+        cached_id = id;
+    }
+    return *cached;
+}
+
+inline double Tracer::now() const {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+}
+
+inline void Tracer::begin(const char* category, const std::string& name, size_t timestep) {
+    thread_buffer().events.push_back(TraceEvent{ true, category, name, timestep, now() });
+}
+
+//' @title end the scope most recently begun on this thread
+inline void Tracer::end() {
+    thread_buffer().events.push_back(TraceEvent{ false, "", "", 0, now() });
+}
+
+//' @title the number of events traced
+inline size_t Tracer::size() const {
+    auto n = size_t(0);
+    for (const auto& buffer : buffers) {
+        n += buffer->events.size();
+    }
+    return n;
+}
+
+//' @title quote a string for JSON
+inline std::string trace_json_string(const std::string& value) {
+    auto quoted = std::string("\"");
+    for (const auto c : value) {
+        switch (c) {
+        case '"': quoted += "\\\""; break;
+        case '\\': quoted += "\\\\"; break;
+        case '\n': quoted += "\\n"; break;
+        case '\t': quoted += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                quoted += escaped;
+            } else {
+                quoted += c;
+            }
+        }
+    }
+    return quoted + "\"";
+}
+
+//' @title write the trace as a Chrome trace JSON file
+//' @description each thread is named after its number, with the thread
+//' which traced first, usually the one which ran the loop, as "thread 0"
+inline void Tracer::write(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        Rcpp::stop("could not open trace file for writing: " + path);
+    }
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto first = true;
+    const auto separate = [&]() {
+        if (!first) {
+            out << ",";
+        }
+        out << "\n";
+        first = false;
+    };
+    char timestamp[32];
+    for (const auto& buffer : buffers) {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << buffer->thread << ",\"args\":{\"name\":\"thread "
+            << buffer->thread << "\"}}";
+        for (const auto& event : buffer->events) {
+            separate();
+            std::snprintf(timestamp, sizeof(timestamp), "%.3f", event.microseconds);
+            if (event.begin) {
+                out << "{\"name\":" << trace_json_string(event.name)
+                    << ",\"cat\":" << trace_json_string(event.category)
+                    << ",\"ph\":\"B\",\"ts\":" << timestamp
+                    << ",\"pid\":1,\"tid\":" << buffer->thread
+                    << ",\"args\":{\"timestep\":" << event.timestep << "}}";
+            } else {
+                out << "{\"ph\":\"E\",\"ts\":" << timestamp
+                    << ",\"pid\":1,\"tid\":" << buffer->thread << "}";
+            }
+        }
+    }
+    out << "\n]}\n";
+    if (!out) {
+        Rcpp::stop("could not write trace file: " + path);
+    }
+}
+
+//' @title trace a scope, from when this is made until it is destroyed
+//' @description does nothing if there is no tracer
+//' It contains the following data members:
+//'     * tracer: the tracer, or nullptr
+class TraceScope {
+    Tracer* tracer;
+
+public:
+    TraceScope(Tracer*, const char* category, const std::string& name, size_t timestep);
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    ~TraceScope();
+};
+
+inline TraceScope::TraceScope(
+    Tracer* tracer,
+    const char* category,
+    const std::string& name,
+    size_t timestep
+) : tracer(tracer) {
+    if (tracer != nullptr) {
+        tracer->begin(category, name, timestep);
+    }
+}
+
+inline TraceScope::~TraceScope() {
+    if (tracer != nullptr) {
+        tracer->end();
+    }
+}
+
+#endif /* INST_INCLUDE_TRACER_H_ */
@@ -0,0 +1,133 @@
+/*
+ * ValuesView.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_VALUES_VIEW_H_
+#define INST_INCLUDE_VALUES_VIEW_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//' @title a read-only view of a variable's values
+//' @description Views refer to the storage of the variable which created them
+//' and so cost nothing to create. Before the variable modifies its values it
+//' calls `detach`, after which the view refers to a private snapshot of the
+//' values it was created with.
+template <class A>
+class ValuesView {
+public:
+    virtual ~ValuesView() = default;
+    virtual size_t size() const = 0;
+    virtual A at(size_t) const = 0;
+    //' @description pointer to contiguous values, or nullptr if the values
+    //' have to be computed element by element
+    virtual const A* data() const = 0;
+    virtual void detach() = 0;
+};
+
+//' @title a view of a vector of values
+//' @description values may be stored in a narrower type, S, in which case they
+//' are converted element by element and there is no contiguous data
+template <class A, class S = A>
+class VectorView : public ValuesView<A> {
+    const std::vector<S>* source;
+    std::vector<S> snapshot;
+
+    static const A* contiguous(const std::vector<A>& v) { return v.data(); }
+    template<class T>
+    static const A* contiguous(const std::vector<T>&) { return nullptr; }
+
+public:
+    VectorView(const std::vector<S>& source);
+    virtual ~VectorView() = default;
+    virtual size_t size() const override;
+    virtual A at(size_t) const override;
+    virtual const A* data() const override;
+    virtual void detach() override;
+};
+
+template<class A, class S>
+inline VectorView<A, S>::VectorView(const std::vector<S>& source) : source(&source) {}
+
+template<class A, class S>
+inline size_t VectorView<A, S>::size() const {
+    return source->size();
+}
+
+template<class A, class S>
+inline A VectorView<A, S>::at(size_t i) const {
+    return (*source)[i];
+}
+
+template<class A, class S>
+inline const A* VectorView<A, S>::data() const {
+    return contiguous(*source);
+}
+
+//' @title take a private copy of the values
+template<class A, class S>
+inline void VectorView<A, S>::detach() {
+    if (source != &snapshot) {
+        snapshot = *source;
+        source = &snapshot;
+    }
+}
+
+//' @title the set of views a variable has handed out
+//' @description Views are held weakly, so that views which have been released
+//' cost nothing when the variable is next modified. Views may be added from
+//' processes which read the same variable in parallel, so the set is guarded.
+//' It contains the following data members:
+//'     * views: the views handed out
+//'     * lock: guards views
+template <class A>
+class ViewRegistry {
+    std::vector<std::weak_ptr<ValuesView<A>>> views;
+    std::mutex lock;
+
+public:
+    ViewRegistry() = default;
+    // views belong to the values they were created from, so are never copied
+    ViewRegistry(const ViewRegistry&) {}
+    ViewRegistry& operator=(const ViewRegistry&) { return *this; }
+    ~ViewRegistry();
+    void add(const std::shared_ptr<ValuesView<A>>&);
+    void detach();
+};
+
+template<class A>
+inline ViewRegistry<A>::~ViewRegistry() {
+    detach();
+}
+
+template<class A>
+inline void ViewRegistry<A>::add(const std::shared_ptr<ValuesView<A>>& view) {
+    std::lock_guard<std::mutex> guard(lock);
+    views.erase(
+        std::remove_if(views.begin(), views.end(), [](const std::weak_ptr<ValuesView<A>>& v) {
+            return v.expired();
+        }),
+        views.end()
+    );
+    views.push_back(view);
+}
+
+//' @title detach all live views
+//' @description should be called before the underlying values are modified
+template<class A>
+inline void ViewRegistry<A>::detach() {
+    std::lock_guard<std::mutex> guard(lock);
+    for (auto& view : views) {
+        if (auto live = view.lock()) {
+            live->detach();
+        }
+    }
+    views.clear();
+}
+
+#endif /* INST_INCLUDE_VALUES_VIEW_H_ */
@@ -7,6 +7,10 @@
 #ifndef INST_INCLUDE_VARIABLE_H_
 #define INST_INCLUDE_VARIABLE_H_
 
+#include "ResizePlan.h"
+#include "Staging.h"
+#include "Checkpoint.h"
+#include <Rcpp.h>
 #include <cstddef>
 
 struct Variable {
@@ -14,6 +18,62 @@ struct Variable {
     virtual void resize() = 0;
     virtual size_t size() const = 0;
     virtual ~Variable() = default;
+
+    virtual void apply_resize(const ResizePlan&) = 0;
+    virtual size_t get_extend_size() const = 0;
+    virtual size_t get_shrink_size() const = 0;
+    virtual size_t get_queue_size() const;
+
+    virtual void enable_tombstones(const double threshold);
+    virtual const Tombstones& get_tombstones() const;
+    virtual Variable* clone() const;
+    virtual void save(CheckpointWriter&) const;
+    virtual void load(CheckpointReader&);
+
+protected:
+    Tombstones tombstones;
+    void follow_tombstones(const ResizePlan&);
 };
 
+//' @title the number of updates queued for the next `update`, see Profiler.h
+inline size_t Variable::get_queue_size() const {
+    return 0;
+}
+
+//' @title keep removed individuals' slots free rather than compacting them
+//' on every resize, see Tombstones
+inline void Variable::enable_tombstones(const double threshold) {
+    tombstones.enable(threshold, size());
+}
+
+inline const Tombstones& Variable::get_tombstones() const {
+    return tombstones;
+}
+
+//' @title a copy of the variable, including its queued changes
+//' @description variables which can be cloned override this. Clones share
+//' their values with the original until either changes, see CopyOnWrite.h,
+//' so a simulation can be forked cheaply
+inline Variable* Variable::clone() const {
+    Rcpp::stop("this variable cannot be cloned");
+}
+
+//' @title write the variable's state, including its queued changes
+//' @description variables which can be checkpointed override this and `load`
+inline void Variable::save(CheckpointWriter&) const {
+    Rcpp::stop("this variable cannot be checkpointed");
+}
+
+//' @title replace the variable's state with one written by `save`
+inline void Variable::load(CheckpointReader&) {
+    Rcpp::stop("this variable cannot be checkpointed");
+}
+
+//' @title keep the free slots of a plan which was made by another structure
+inline void Variable::follow_tombstones(const ResizePlan& plan) {
+    if (plan.tombstones != nullptr && plan.tombstones != &tombstones) {
+        tombstones = *plan.tombstones;
+    }
+}
+
 #endif /* INST_INCLUDE_VARIABLE_H_ */
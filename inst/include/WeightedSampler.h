@@ -0,0 +1,184 @@
+/*
+ * WeightedSampler.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef INST_INCLUDE_WEIGHTED_SAMPLER_H_
+#define INST_INCLUDE_WEIGHTED_SAMPLER_H_
+
+#include "DoubleVariable.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+//' @title sample individuals in proportion to the values of a variable
+//' @description The weights of the individuals in an index are copied into
+//' an alias table (Vose's method) in O(n), after which each sample with
+//' replacement costs O(1). Samples without replacement use exponential keys,
+//' which is O(n) per call. The table is kept until the variable's values or
+//' the index change, so a sampler which is called every timestep only
+//' rebuilds it when it has to.
+//' It contains the following data members:
+//'     * variable: the variable holding the weights
+//'     * index: the individuals in the table
+//'     * version: the version of the variable the table was built from
+//'     * individuals: the individuals in the table, in order
+//'     * weights: the weight of each individual in the table
+//'     * probability, alias: the alias table
+class WeightedSampler {
+
+    const DoubleVariable& variable;
+    individual_index_t index;
+    size_t version = 0;
+    bool built = false;
+    std::vector<size_t> individuals;
+    std::vector<double> weights;
+    std::vector<double> probability;
+    std::vector<size_t> alias;
+    double total = 0;
+
+    void build(const individual_index_t&);
+
+public:
+    WeightedSampler(const DoubleVariable& variable);
+    virtual ~WeightedSampler() = default;
+
+    virtual std::vector<size_t> sample_with_replacement(const individual_index_t&, const size_t);
+    virtual individual_index_t sample_without_replacement(const individual_index_t&, const size_t);
+};
+
+inline WeightedSampler::WeightedSampler(const DoubleVariable& variable)
+    : variable(variable), index(variable.size()) {}
+
+//' @title build the alias table for an index, unless it is already built
+inline void WeightedSampler::build(const individual_index_t& new_index) {
+    if (new_index.max_size() != variable.size()) {
+        Rcpp::stop("incompatible size bitset used for weighted sampling");
+    }
+    if (built && version == variable.get_version() && index == new_index) {
+        return;
+    }
+    index = new_index;
+    version = variable.get_version();
+    individuals.assign(index.cbegin(), index.cend());
+    const auto n = individuals.size();
+    const auto view = variable.get_values_view();
+    weights.resize(n);
+    total = 0;
+    for (auto i = 0u; i < n; ++i) {
+        const auto w = view->at(individuals[i]);
+        if (!(w >= 0) || std::isinf(w)) {
+            std::stringstream message;
+            message << "invalid weight for weighted sampling: " << w;
+            Rcpp::stop(message.str());
+        }
+        weights[i] = w;
+        total += w;
+    }
+
+    // Vose's alias method
+    probability.resize(n);
+    alias.assign(n, 0);
+    auto small = std::vector<size_t>();
+    auto large = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        probability[i] = total > 0 ? weights[i] * n / total : 0;
+        if (probability[i] < 1) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        const auto s = small.back();
+        small.pop_back();
+        const auto l = large.back();
+        alias[s] = l;
+        probability[l] -= 1 - probability[s];
+        if (probability[l] < 1) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // the remainder are 1 up to rounding error
+    for (auto i : large) {
+        probability[i] = 1;
+    }
+    for (auto i : small) {
+        probability[i] = 1;
+    }
+    built = true;
+}
+
+//' @title draw k individuals from an index with replacement
+//' @return the sampled individuals, in the order they were drawn
+inline std::vector<size_t> WeightedSampler::sample_with_replacement(
+    const individual_index_t& new_index,
+    const size_t k
+) {
+    build(new_index);
+    if (k == 0) {
+        return std::vector<size_t>();
+    }
+    if (!(total > 0)) {
+        Rcpp::stop("no individuals with positive weight to sample");
+    }
+    const auto n = individuals.size();
+    const auto random = random_uniform(k);
+    auto result = std::vector<size_t>(k);
+    for (auto i = 0u; i < k; ++i) {
+        const auto x = random[i] * n;
+        const auto column = std::min(static_cast<size_t>(x), n - 1);
+        const auto chosen = (x - column) < probability[column] ? column : alias[column];
+        result[i] = individuals[chosen];
+    }
+    return result;
+}
+
+//' @title draw k distinct individuals from an index
+//' @description each individual gets the key log(u) / w, the k largest keys
+//' are a weighted sample without replacement (Efraimidis & Spirakis, 2006)
+inline individual_index_t WeightedSampler::sample_without_replacement(
+    const individual_index_t& new_index,
+    const size_t k
+) {
+    build(new_index);
+    const auto n = individuals.size();
+    const auto positive = std::count_if(
+        weights.cbegin(),
+        weights.cend(),
+        [](const double w) { return w > 0; }
+    );
+    if (k > static_cast<size_t>(positive)) {
+        Rcpp::stop("not enough individuals with positive weight to sample without replacement");
+    }
+    auto result = individual_index_t(variable.size());
+    if (k == 0) {
+        return result;
+    }
+    const auto random = random_uniform(n);
+    auto keys = std::vector<std::pair<double, size_t>>(n);
+    for (auto i = 0u; i < n; ++i) {
+        keys[i] = {
+            weights[i] > 0 ?
+                std::log(random[i]) / weights[i] :
+                -std::numeric_limits<double>::infinity(),
+            individuals[i]
+        };
+    }
+    std::nth_element(
+        keys.begin(),
+        keys.begin() + (k - 1),
+        keys.end(),
+        std::greater<std::pair<double, size_t>>()
+    );
+    for (auto i = 0u; i < k; ++i) {
+        result.insert(keys[i].second);
+    }
+    return result;
+}
+
+#endif /* INST_INCLUDE_WEIGHTED_SAMPLER_H_ */
@@ -0,0 +1,213 @@
+/*
+ * aggregation.h
+ *
+ *  Created on: 18 Oct 2026
+ *
+ *  Single pass aggregation kernels for numeric variables
+ */
+
+#ifndef INST_INCLUDE_AGGREGATION_H_
+#define INST_INCLUDE_AGGREGATION_H_
+
+#include "CategoricalVariable.h"
+#include "ValuesView.h"
+#include "common_types.h"
+#include <Rcpp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+//' @title summary statistics of a set of values
+//' @description count, sum, min and max are accumulated as values are added,
+//' min and max are infinite when no values have been added
+struct summary_t {
+    size_t count = 0;
+    double sum = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    void add(const double value) {
+        ++count;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    double mean() const {
+        return sum / count;
+    }
+};
+
+//' @title apply a function to each value in a view at an index
+//' @description uses the view's contiguous data when it has any, so that the
+//' loop does not make a virtual call for each value
+//' @param view the values to visit
+//' @param index the individuals to visit
+//' @param f a function taking an individual and their value
+template<class A, class F>
+inline void for_each_value(
+    const ValuesView<A>& view,
+    const individual_index_t& index,
+    F f
+) {
+    if (index.max_size() != view.size()) {
+        Rcpp::stop("incompatible size bitset used to aggregate a variable");
+    }
+    const auto data = view.data();
+    if (data != nullptr) {
+        for (auto i : index) {
+            f(i, data[i]);
+        }
+    } else {
+        for (auto i : index) {
+            f(i, view.at(i));
+        }
+    }
+}
+
+//' @title summarise the values of a variable at an index
+template<class A>
+inline summary_t summarise_values(
+    const ValuesView<A>& view,
+    const individual_index_t& index
+) {
+    auto result = summary_t();
+    for_each_value(view, index, [&](size_t, const A value) {
+        result.add(value);
+    });
+    return result;
+}
+
+//' @title summarise the values of a variable at an index for each category of
+//' a categorical variable
+//' @description the index is walked once, adding each individual's value to
+//' the summary of each category they are in
+//' @param view the values to summarise
+//' @param index the individuals to summarise
+//' @param variable the variable to group individuals by
+//' @param categories the categories to return summaries for
+template<class A>
+inline std::vector<summary_t> summarise_values_by_category(
+    const ValuesView<A>& view,
+    const individual_index_t& index,
+    const CategoricalVariable& variable,
+    const std::vector<std::string>& categories
+) {
+    if (variable.size() != view.size()) {
+        Rcpp::stop("variables to aggregate must be the same size");
+    }
+    auto members = std::vector<const individual_index_t*>();
+    members.reserve(categories.size());
+    for (const auto& category : categories) {
+        members.push_back(&variable.get_category_index(category));
+    }
+    auto result = std::vector<summary_t>(categories.size());
+    for_each_value(view, index, [&](size_t i, const A value) {
+        for (auto c = 0u; c < members.size(); ++c) {
+            if (members[c]->find(i) != members[c]->cend()) {
+                result[c].add(value);
+            }
+        }
+    });
+    return result;
+}
+
+//' @title summarise the values of a variable at an index for each value of an
+//' integer variable
+//' @description individuals are grouped by their integer value, individuals
+//' in groups which were not asked for are not counted. Groups are looked up
+//' in a table over [min(groups), max(groups)] when they are close together,
+//' and in a hash map otherwise, so that far apart groups such as 1 and 1e9 do
+//' not need a table entry for every value in between.
+//' @param view the values to summarise
+//' @param index the individuals to summarise
+//' @param groups the group of each individual
+//' @param requested the groups to return summaries for, in order
+template<class A>
+inline std::vector<summary_t> summarise_values_by_group(
+    const ValuesView<A>& view,
+    const individual_index_t& index,
+    const ValuesView<int>& groups,
+    const std::vector<int>& requested
+) {
+    if (groups.size() != view.size()) {
+        Rcpp::stop("variables to aggregate must be the same size");
+    }
+    if (requested.empty()) {
+        Rcpp::stop("no groups to aggregate by");
+    }
+    // a group asked for more than once is summarised once, at its first position
+    auto positions = std::unordered_map<int, size_t>();
+    auto first_position = std::vector<size_t>(requested.size());
+    for (auto k = 0u; k < requested.size(); ++k) {
+        first_position[k] = positions.emplace(requested[k], k).first->second;
+    }
+    auto result = std::vector<summary_t>(requested.size());
+    const auto group_data = groups.data();
+    const auto group_of = [&](size_t i) {
+        return group_data != nullptr ? group_data[i] : groups.at(i);
+    };
+
+    const auto bounds = std::minmax_element(requested.cbegin(), requested.cend());
+    const auto first = static_cast<int64_t>(*bounds.first);
+    const auto range = static_cast<size_t>(*bounds.second - first + 1);
+    if (range <= 4 * requested.size() + 64) {
+        const auto none = requested.size();
+        auto table = std::vector<size_t>(range, none);
+        for (const auto& entry : positions) {
+            table[entry.first - first] = entry.second;
+        }
+        for_each_value(view, index, [&](size_t i, const A value) {
+            const auto offset = group_of(i) - first;
+            if (offset >= 0 && static_cast<size_t>(offset) < range && table[offset] != none) {
+                result[table[offset]].add(value);
+            }
+        });
+    } else {
+        for_each_value(view, index, [&](size_t i, const A value) {
+            const auto it = positions.find(group_of(i));
+            if (it != positions.cend()) {
+                result[it->second].add(value);
+            }
+        });
+    }
+
+    for (auto k = 0u; k < requested.size(); ++k) {
+        result[k] = result[first_position[k]];
+    }
+    return result;
+}
+
+//' @title count the values of a variable at an index in equal width bins
+//' @description bins divide [lower, upper] into n_bins intervals, each of which
+//' is closed on the left and open on the right, apart from the last which is
+//' closed on both. Values outside of [lower, upper] are not counted.
+template<class A>
+inline std::vector<size_t> histogram_values(
+    const ValuesView<A>& view,
+    const individual_index_t& index,
+    const double lower,
+    const double upper,
+    const size_t n_bins
+) {
+    if (!(lower < upper) || n_bins == 0) {
+        Rcpp::stop("invalid bins for histogram");
+    }
+    auto result = std::vector<size_t>(n_bins, 0);
+    const auto scale = n_bins / (upper - lower);
+    for_each_value(view, index, [&](size_t, const A value) {
+        if (value < lower || upper < value || std::isnan(value)) {
+            return;
+        }
+        const auto bin = std::min(
+            static_cast<size_t>((value - lower) * scale),
+            n_bins - 1
+        );
+        ++result[bin];
+    });
+    return result;
+}
+
+#endif /* INST_INCLUDE_AGGREGATION_H_ */
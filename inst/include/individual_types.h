@@ -12,8 +12,13 @@
 #include "CategoricalVariable.h"
 #include "IntegerVariable.h"
 #include "DoubleVariable.h"
+#include "CompactVariable.h"
+#include "TimeSinceVariable.h"
 #include "RaggedInteger.h"
 #include "RaggedDouble.h"
 #include "Event.h"
+#include "Population.h"
+#include "Simulation.h"
+#include "Render.h"
 
 #endif /* INDIVIDUAL_TYPES_H_ */
@@ -11,15 +11,39 @@
 #define VECTOR_VARIABLES_H_
 
 #include "common_types.h"
+#include "ResizePlan.h"
+#include <Rcpp.h>
+#include <algorithm>
 #include <queue>
+#include <sstream>
+
+//' @title Run a function over chunks of a variable's values
+//' @description chunks are aligned to the 64 bit words of a bitset over the
+//' same individuals and may run in parallel, see ParallelPolicy.h
+//' @param size the number of values
+//' @param f a function of the first and one past the last value of a chunk,
+//' returning a count
+//' @return the sum of the counts for each chunk
+template<class F>
+inline size_t for_each_chunk(size_t size, F f) {
+    const auto num_bits = size_t(64);
+    return parallel_for_words(size / num_bits + 1, [&](size_t begin, size_t end) {
+        return f(
+            std::min(begin * num_bits, size),
+            std::min(end * num_bits, size)
+        );
+    });
+}
 
 //' @title Apply state updates to a vector-based variable
+//' @description values may be stored in a narrower type, S, than the type of
+//' the updates, A
 //' @param updates queue of value/index pairs to apply in FIFO order
 //' @param values variable values to update
-template<class A>
+template<class A, class S>
 inline void vector_update(
     std::queue<std::pair<std::vector<A>, std::vector<size_t>>>& updates,
-    std::vector<A>& values
+    std::vector<S>& values
     ) {
     while(updates.size() > 0) {
         const auto& update = updates.front();
@@ -32,9 +56,22 @@ inline void vector_update(
         if (vector_replacement) {
             // For a full vector replacement
             if (value_fill) {
-                std::fill(values.begin(), values.end(), new_values[0]);
+                const auto value = new_values[0];
+                for_each_chunk(values.size(), [&](size_t begin, size_t end) {
+                    std::fill(values.begin() + begin, values.begin() + end, value);
+                    return end - begin;
+                });
+            } else if (new_values.size() == values.size()) {
+                for_each_chunk(values.size(), [&](size_t begin, size_t end) {
+                    std::copy(
+                        new_values.cbegin() + begin,
+                        new_values.cbegin() + end,
+                        values.begin() + begin
+                    );
+                    return end - begin;
+                });
             } else {
-                values = new_values;
+                values.assign(new_values.cbegin(), new_values.cend());
             }
         } else {
             if (value_fill) {
@@ -53,54 +90,221 @@ inline void vector_update(
     }
 }
 
+//' @title Remove the elements of a vector which are in a bitset
+//' @description compacts the vector in place, preserving the order of the
+//' remaining elements. The bitset is read one word at a time, words with no
+//' removals are skipped and each run of surviving elements is moved once
+//' (a memmove for trivially copyable types). Nothing is allocated.
+//' @param values the vector to compact
+//' @param index the elements to remove
+template<class S>
+inline void compact_vector(
+    std::vector<S>& values,
+    const individual_index_t& index
+) {
+    const auto& words = index.words();
+    const auto num_bits = sizeof(words[0]) * 8;
+    auto begin = values.begin();
+    size_t read = 0;
+    size_t write = 0;
+    for (auto w = 0u; w < words.size(); ++w) {
+        auto word = words[w];
+        while (word) {
+            const auto removed = w * num_bits + ctz(word);
+            if (write != read) {
+                std::move(begin + read, begin + removed, begin + write);
+            }
+            write += removed - read;
+            read = removed + 1;
+            word &= word - 1;
+        }
+    }
+    if (write != read) {
+        std::move(begin + read, values.end(), begin + write);
+    }
+    write += values.size() - read;
+    values.erase(begin + write, values.end());
+}
+
+//' @title Resize a vector-based variable without tombstones
+//' @description removed values are compacted away in place and new values
+//' are appended, without making a ResizePlan
+//' @param values a vector-based variable's value vector
+//' @param shrink_index the individuals to remove
+//' @param extend_values the new values, in order
+template<class A, class S>
+inline void resize_vector(
+    std::vector<S>& values,
+    const individual_index_t& shrink_index,
+    std::vector<A>& extend_values
+) {
+    if (shrink_index.size() > 0) {
+        compact_vector(values, shrink_index);
+    }
+    values.insert(values.cend(), extend_values.cbegin(), extend_values.cend());
+    extend_values.clear();
+}
+
 //' @title Resize a vector-based variable
-//' @description performs shrinking and extending operations on a variable's
-//value vector.
+//' @description applies a resize plan to a variable's value vector. If
+//' tombstones are enabled, removed values are reset rather than erased.
 //' @param values a vector-based variable's value vector
-//' @param shrink_index index of indices to remove
-//' @param extend_values values to append to the values vector
-template<class A>
+//' @param plan the individuals to remove and the slots for new values
+//' @param extend_values the new values, in order
+template<class A, class S>
 inline void resize_vector(
-    std::vector<A>& values, 
-    individual_index_t& shrink_index,
+    std::vector<S>& values, 
+    const ResizePlan& plan,
     std::vector<A>& extend_values
 ) {
-    auto size_changed = false;
+    if (plan.tombstones == nullptr) {
+        if (!plan.removed_vector.empty()) {
+            compact_vector(values, plan.removed);
+        }
+    } else {
+        for (auto i : plan.removed_vector) {
+            values[i] = S();
+        }
+    }
 
-    // Apply shrink updates
-    if (shrink_index.size() > 0) {
-        const auto index = std::vector<size_t>(
-            shrink_index.cbegin(),
-            shrink_index.cend()
-        );
-        auto new_values = std::vector<A>();
-        new_values.reserve(values.size() - index.size());
-        auto it = index.cbegin();
-        for (auto i = 0u; i < values.size(); ++i) {
-            if (it != index.cend() && i == *it) {
-                ++it;
-            } else {
-                new_values.push_back(values[i]);
-            }
+    values.resize(plan.allocated_size);
+    for (auto i = 0u; i < plan.slots.size(); ++i) {
+        values[plan.slots[i]] = extend_values[i];
+    }
+    extend_values.clear();
+
+    if (!plan.compacted_vector.empty()) {
+        compact_vector(values, plan.compacted);
+    }
+}
+
+//' @title Get the values of a vector-based variable at the index given by a bitset
+//' @param values a vector-based variable's value vector
+//' @param index the individuals to return values for
+template<class A, class S>
+inline std::vector<A> vector_get_values(
+    const std::vector<S>& values,
+    const individual_index_t& index
+) {
+    if (values.size() != index.max_size()) {
+        Rcpp::stop("incompatible size bitset used to get values from NumericVariable");
+    }
+    auto result = std::vector<A>(index.size());
+    auto result_i = 0u;
+    for (auto i : index) {
+        result[result_i] = values[i];
+        ++result_i;
+    }
+    return result;
+}
+
+//' @title Get the values of a vector-based variable at the index given by a vector
+//' @param values a vector-based variable's value vector
+//' @param index the individuals to return values for
+template<class A, class S>
+inline std::vector<A> vector_get_values(
+    const std::vector<S>& values,
+    const std::vector<size_t>& index
+) {
+    auto result = std::vector<A>(index.size());
+    for (auto i = 0u; i < index.size(); ++i) {
+        if (index[i] >= values.size()) {
+            std::stringstream message;
+            message << "index for NumericVariable out of range, supplied index: ";
+            message << index[i] << ", size of variable: " << values.size();
+            Rcpp::stop(message.str()); 
         }
-        values = new_values;
-        shrink_index.clear();
-        size_changed = true;
+        result[i] = values[index[i]];
     }
+    return result;
+}
 
-    // Apply extension updates
-    if (extend_values.size() > 0) {
-        values.insert(
-            values.cend(), 
-            extend_values.cbegin(),
-            extend_values.cend()
-        );
-        extend_values.clear();
+//' @title predicate for values in the range [a,b]
+template<class A>
+struct in_range {
+    const A a;
+    const A b;
+    template<class S>
+    bool operator()(const S v) const {
+        return !(v < a) && !(b < v);
     }
+};
 
-    if (size_changed) {
-        shrink_index = individual_index_t(values.size());
+//' @title predicate for values equal to one of a set of values
+template<class A>
+struct in_set {
+    const std::vector<A>& values_set;
+    template<class S>
+    bool operator()(const S v) const {
+        auto findit = std::find(values_set.begin(), values_set.end(), v);
+        return findit != values_set.end();
+    }
+};
+
+//' @title predicate for values equal to a specific scalar
+template<class A>
+struct equal_to_value {
+    const A value;
+    template<class S>
+    bool operator()(const S v) const {
+        return v == value;
+    }
+};
+
+//' @title Find the individuals whose value satisfies a predicate
+//' @param values a vector-based variable's value vector
+//' @param tombstones free slots, which are never returned
+//' @param predicate a function of a single value, which may be called from
+//' several threads at once
+template<class S, class F>
+inline individual_index_t vector_index_where(
+    const std::vector<S>& values,
+    const Tombstones& tombstones,
+    F predicate
+) {
+    auto result = individual_index_t(values.size());
+    const auto num_bits = size_t(64);
+    result.assign_words([&](size_t w) {
+        auto word = uint64_t(0);
+        const auto begin = w * num_bits;
+        const auto end = std::min(begin + num_bits, values.size());
+        for (auto i = begin; i < end; ++i) {
+            if (predicate(values[i])) {
+                word |= uint64_t(1) << (i - begin);
+            }
+        }
+        return word;
+    });
+    for (auto i : tombstones.get_free()) {
+        result.erase(i);
+    }
+    return result;
+}
+
+//' @title Count the individuals whose value satisfies a predicate
+//' @param values a vector-based variable's value vector
+//' @param tombstones free slots, which are never counted
+//' @param predicate a function of a single value, which may be called from
+//' several threads at once
+template<class S, class F>
+inline size_t vector_count_where(
+    const std::vector<S>& values,
+    const Tombstones& tombstones,
+    F predicate
+) {
+    auto result = for_each_chunk(values.size(), [&](size_t begin, size_t end) {
+        return static_cast<size_t>(std::count_if(
+            values.cbegin() + begin,
+            values.cbegin() + end,
+            predicate
+        ));
+    });
+    for (auto i : tombstones.get_free()) {
+        if (predicate(values[i])) {
+            --result;
+        }
     }
+    return result;
 }
 
 #endif /* VECTOR_VARIABLES_H_ */
@@ -14,6 +14,116 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
+// double_variable_summarise
+Rcpp::List double_variable_summarise(Rcpp::XPtr<DoubleVariable> variable, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_double_variable_summarise(SEXP variableSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_variable_summarise(variable, index));
+    return rcpp_result_gen;
+END_RCPP
+}
+// double_variable_summarise_by_category
+Rcpp::List double_variable_summarise_by_category(Rcpp::XPtr<DoubleVariable> variable, Rcpp::XPtr<individual_index_t> index, Rcpp::XPtr<CategoricalVariable> by, const std::vector<std::string> categories);
+RcppExport SEXP _individual_double_variable_summarise_by_category(SEXP variableSEXP, SEXP indexSEXP, SEXP bySEXP, SEXP categoriesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<CategoricalVariable> >::type by(bySEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string> >::type categories(categoriesSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_variable_summarise_by_category(variable, index, by, categories));
+    return rcpp_result_gen;
+END_RCPP
+}
+// double_variable_summarise_by_group
+Rcpp::List double_variable_summarise_by_group(Rcpp::XPtr<DoubleVariable> variable, Rcpp::XPtr<individual_index_t> index, Rcpp::XPtr<IntegerVariable> by, const std::vector<int> groups);
+RcppExport SEXP _individual_double_variable_summarise_by_group(SEXP variableSEXP, SEXP indexSEXP, SEXP bySEXP, SEXP groupsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type by(bySEXP);
+    Rcpp::traits::input_parameter< const std::vector<int> >::type groups(groupsSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_variable_summarise_by_group(variable, index, by, groups));
+    return rcpp_result_gen;
+END_RCPP
+}
+// double_variable_histogram
+std::vector<size_t> double_variable_histogram(Rcpp::XPtr<DoubleVariable> variable, Rcpp::XPtr<individual_index_t> index, const double lower, const double upper, const size_t n_bins);
+RcppExport SEXP _individual_double_variable_histogram(SEXP variableSEXP, SEXP indexSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP n_binsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< const double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< const double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type n_bins(n_binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_variable_histogram(variable, index, lower, upper, n_bins));
+    return rcpp_result_gen;
+END_RCPP
+}
+// integer_variable_summarise
+Rcpp::List integer_variable_summarise(Rcpp::XPtr<IntegerVariable> variable, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_integer_variable_summarise(SEXP variableSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_variable_summarise(variable, index));
+    return rcpp_result_gen;
+END_RCPP
+}
+// integer_variable_summarise_by_category
+Rcpp::List integer_variable_summarise_by_category(Rcpp::XPtr<IntegerVariable> variable, Rcpp::XPtr<individual_index_t> index, Rcpp::XPtr<CategoricalVariable> by, const std::vector<std::string> categories);
+RcppExport SEXP _individual_integer_variable_summarise_by_category(SEXP variableSEXP, SEXP indexSEXP, SEXP bySEXP, SEXP categoriesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<CategoricalVariable> >::type by(bySEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string> >::type categories(categoriesSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_variable_summarise_by_category(variable, index, by, categories));
+    return rcpp_result_gen;
+END_RCPP
+}
+// integer_variable_summarise_by_group
+Rcpp::List integer_variable_summarise_by_group(Rcpp::XPtr<IntegerVariable> variable, Rcpp::XPtr<individual_index_t> index, Rcpp::XPtr<IntegerVariable> by, const std::vector<int> groups);
+RcppExport SEXP _individual_integer_variable_summarise_by_group(SEXP variableSEXP, SEXP indexSEXP, SEXP bySEXP, SEXP groupsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type by(bySEXP);
+    Rcpp::traits::input_parameter< const std::vector<int> >::type groups(groupsSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_variable_summarise_by_group(variable, index, by, groups));
+    return rcpp_result_gen;
+END_RCPP
+}
+// integer_variable_histogram
+std::vector<size_t> integer_variable_histogram(Rcpp::XPtr<IntegerVariable> variable, Rcpp::XPtr<individual_index_t> index, const double lower, const double upper, const size_t n_bins);
+RcppExport SEXP _individual_integer_variable_histogram(SEXP variableSEXP, SEXP indexSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP n_binsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< const double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< const double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type n_bins(n_binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_variable_histogram(variable, index, lower, upper, n_bins));
+    return rcpp_result_gen;
+END_RCPP
+}
 // create_bitset
 Rcpp::XPtr<individual_index_t> create_bitset(size_t size);
 RcppExport SEXP _individual_create_bitset(SEXP sizeSEXP) {
@@ -339,6 +449,34 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// checkpoint_save_native
+void checkpoint_save_native(const std::string path, const Rcpp::List variables, const Rcpp::List events, const Rcpp::List populations);
+RcppExport SEXP _individual_checkpoint_save_native(SEXP pathSEXP, SEXP variablesSEXP, SEXP eventsSEXP, SEXP populationsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type variables(variablesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type events(eventsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type populations(populationsSEXP);
+    checkpoint_save_native(path, variables, events, populations);
+    return R_NilValue;
+END_RCPP
+}
+// checkpoint_restore_native
+bool checkpoint_restore_native(const std::string path, const Rcpp::List variables, const Rcpp::List events, const Rcpp::List populations, bool restore_random);
+RcppExport SEXP _individual_checkpoint_restore_native(SEXP pathSEXP, SEXP variablesSEXP, SEXP eventsSEXP, SEXP populationsSEXP, SEXP restore_randomSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type variables(variablesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type events(eventsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type populations(populationsSEXP);
+    Rcpp::traits::input_parameter< bool >::type restore_random(restore_randomSEXP);
+    rcpp_result_gen = Rcpp::wrap(checkpoint_restore_native(path, variables, events, populations, restore_random));
+    return rcpp_result_gen;
+END_RCPP
+}
 // dummy
 void dummy();
 static SEXP _individual_dummy_try() {
@@ -372,13 +510,14 @@ RcppExport SEXP _individual_dummy() {
     return rcpp_result_gen;
 }
 // create_double_variable
-Rcpp::XPtr<DoubleVariable> create_double_variable(const std::vector<double>& values);
-RcppExport SEXP _individual_create_double_variable(SEXP valuesSEXP) {
+Rcpp::XPtr<DoubleVariable> create_double_variable(const std::vector<double>& values, const std::string storage);
+RcppExport SEXP _individual_create_double_variable(SEXP valuesSEXP, SEXP storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
-    rcpp_result_gen = Rcpp::wrap(create_double_variable(values));
+    Rcpp::traits::input_parameter< const std::string >::type storage(storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_double_variable(values, storage));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -393,6 +532,17 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// double_variable_get_values_view
+SEXP double_variable_get_values_view(Rcpp::XPtr<DoubleVariable> variable);
+RcppExport SEXP _individual_double_variable_get_values_view(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_variable_get_values_view(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
 // double_variable_get_values_at_index
 std::vector<double> double_variable_get_values_at_index(Rcpp::XPtr<DoubleVariable> variable, Rcpp::XPtr<individual_index_t> index);
 RcppExport SEXP _individual_double_variable_get_values_at_index(SEXP variableSEXP, SEXP indexSEXP) {
@@ -754,14 +904,58 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// targeted_event_enable_tombstones
+void targeted_event_enable_tombstones(const Rcpp::XPtr<TargetedEvent> event, double threshold);
+RcppExport SEXP _individual_targeted_event_enable_tombstones(SEXP eventSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::XPtr<TargetedEvent> >::type event(eventSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    targeted_event_enable_tombstones(event, threshold);
+    return R_NilValue;
+END_RCPP
+}
+// targeted_event_get_free
+Rcpp::XPtr<individual_index_t> targeted_event_get_free(const Rcpp::XPtr<TargetedEvent> event);
+RcppExport SEXP _individual_targeted_event_get_free(SEXP eventSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::XPtr<TargetedEvent> >::type event(eventSEXP);
+    rcpp_result_gen = Rcpp::wrap(targeted_event_get_free(event));
+    return rcpp_result_gen;
+END_RCPP
+}
+// targeted_event_enable_reverse_index
+void targeted_event_enable_reverse_index(const Rcpp::XPtr<TargetedEvent> event);
+RcppExport SEXP _individual_targeted_event_enable_reverse_index(SEXP eventSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::XPtr<TargetedEvent> >::type event(eventSEXP);
+    targeted_event_enable_reverse_index(event);
+    return R_NilValue;
+END_RCPP
+}
+// event_clone
+Rcpp::XPtr<EventBase> event_clone(const Rcpp::XPtr<EventBase> event);
+RcppExport SEXP _individual_event_clone(SEXP eventSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::XPtr<EventBase> >::type event(eventSEXP);
+    rcpp_result_gen = Rcpp::wrap(event_clone(event));
+    return rcpp_result_gen;
+END_RCPP
+}
 // create_integer_variable
-Rcpp::XPtr<IntegerVariable> create_integer_variable(const std::vector<int>& values);
-RcppExport SEXP _individual_create_integer_variable(SEXP valuesSEXP) {
+Rcpp::XPtr<IntegerVariable> create_integer_variable(const std::vector<int>& values, const std::string storage);
+RcppExport SEXP _individual_create_integer_variable(SEXP valuesSEXP, SEXP storageSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const std::vector<int>& >::type values(valuesSEXP);
-    rcpp_result_gen = Rcpp::wrap(create_integer_variable(values));
+    Rcpp::traits::input_parameter< const std::string >::type storage(storageSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_integer_variable(values, storage));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -776,6 +970,17 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// integer_variable_get_values_view
+SEXP integer_variable_get_values_view(Rcpp::XPtr<IntegerVariable> variable);
+RcppExport SEXP _individual_integer_variable_get_values_view(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<IntegerVariable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_variable_get_values_view(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
 // integer_variable_get_values_at_index
 std::vector<int> integer_variable_get_values_at_index(Rcpp::XPtr<IntegerVariable> variable, Rcpp::XPtr<individual_index_t> index);
 RcppExport SEXP _individual_integer_variable_get_values_at_index(SEXP variableSEXP, SEXP indexSEXP) {
@@ -942,6 +1147,106 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// create_population
+Rcpp::XPtr<Population> create_population(size_t size);
+RcppExport SEXP _individual_create_population(SEXP sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< size_t >::type size(sizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_population(size));
+    return rcpp_result_gen;
+END_RCPP
+}
+// population_add_variable
+void population_add_variable(Rcpp::XPtr<Population> population, Rcpp::XPtr<Variable> variable);
+RcppExport SEXP _individual_population_add_variable(SEXP populationSEXP, SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Variable> >::type variable(variableSEXP);
+    population_add_variable(population, variable);
+    return R_NilValue;
+END_RCPP
+}
+// population_add_targeted_event
+void population_add_targeted_event(Rcpp::XPtr<Population> population, Rcpp::XPtr<TargetedEvent> event);
+RcppExport SEXP _individual_population_add_targeted_event(SEXP populationSEXP, SEXP eventSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<TargetedEvent> >::type event(eventSEXP);
+    population_add_targeted_event(population, event);
+    return R_NilValue;
+END_RCPP
+}
+// population_queue_shrink
+void population_queue_shrink(Rcpp::XPtr<Population> population, std::vector<size_t>& index);
+RcppExport SEXP _individual_population_queue_shrink(SEXP populationSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< std::vector<size_t>& >::type index(indexSEXP);
+    population_queue_shrink(population, index);
+    return R_NilValue;
+END_RCPP
+}
+// population_queue_shrink_bitset
+void population_queue_shrink_bitset(Rcpp::XPtr<Population> population, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_population_queue_shrink_bitset(SEXP populationSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    population_queue_shrink_bitset(population, index);
+    return R_NilValue;
+END_RCPP
+}
+// population_enable_tombstones
+void population_enable_tombstones(Rcpp::XPtr<Population> population, double threshold);
+RcppExport SEXP _individual_population_enable_tombstones(SEXP populationSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    population_enable_tombstones(population, threshold);
+    return R_NilValue;
+END_RCPP
+}
+// population_get_size
+size_t population_get_size(Rcpp::XPtr<Population> population);
+RcppExport SEXP _individual_population_get_size(SEXP populationSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    rcpp_result_gen = Rcpp::wrap(population_get_size(population));
+    return rcpp_result_gen;
+END_RCPP
+}
+// population_resize
+void population_resize(Rcpp::XPtr<Population> population);
+RcppExport SEXP _individual_population_resize(SEXP populationSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    population_resize(population);
+    return R_NilValue;
+END_RCPP
+}
+// population_clone
+Rcpp::XPtr<Population> population_clone(Rcpp::XPtr<Population> population, const Rcpp::List variables, const Rcpp::List events);
+RcppExport SEXP _individual_population_clone(SEXP populationSEXP, SEXP variablesSEXP, SEXP eventsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Population> >::type population(populationSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type variables(variablesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type events(eventsSEXP);
+    rcpp_result_gen = Rcpp::wrap(population_clone(population, variables, events));
+    return rcpp_result_gen;
+END_RCPP
+}
 // fixed_probability_multinomial_process_internal
 Rcpp::XPtr<process_t> fixed_probability_multinomial_process_internal(Rcpp::XPtr<CategoricalVariable> variable, const std::string source_state, const std::vector<std::string> destination_states, const double rate, const std::vector<double> destination_probabilities);
 RcppExport SEXP _individual_fixed_probability_multinomial_process_internal(SEXP variableSEXP, SEXP source_stateSEXP, SEXP destination_statesSEXP, SEXP rateSEXP, SEXP destination_probabilitiesSEXP) {
@@ -1005,6 +1310,78 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// categorical_count_renderer_process_internal
+Rcpp::XPtr<process_t> categorical_count_renderer_process_internal(Rcpp::XPtr<Render> renderer, Rcpp::XPtr<CategoricalVariable> variable, const std::vector<std::string> categories);
+RcppExport SEXP _individual_categorical_count_renderer_process_internal(SEXP rendererSEXP, SEXP variableSEXP, SEXP categoriesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Render> >::type renderer(rendererSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<CategoricalVariable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string> >::type categories(categoriesSEXP);
+    rcpp_result_gen = Rcpp::wrap(categorical_count_renderer_process_internal(renderer, variable, categories));
+    return rcpp_result_gen;
+END_RCPP
+}
+// create_profiler
+Rcpp::XPtr<Profiler> create_profiler();
+RcppExport SEXP _individual_create_profiler() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(create_profiler());
+    return rcpp_result_gen;
+END_RCPP
+}
+// name_table_name_processes
+void name_table_name_processes(Rcpp::XPtr<NameTable> table, const std::vector<std::string> names);
+RcppExport SEXP _individual_name_table_name_processes(SEXP tableSEXP, SEXP namesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<NameTable> >::type table(tableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string> >::type names(namesSEXP);
+    name_table_name_processes(table, names);
+    return R_NilValue;
+END_RCPP
+}
+// name_table_name_structures
+void name_table_name_structures(Rcpp::XPtr<NameTable> table, const Rcpp::List structures, const std::vector<std::string> names);
+RcppExport SEXP _individual_name_table_name_structures(SEXP tableSEXP, SEXP structuresSEXP, SEXP namesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<NameTable> >::type table(tableSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type structures(structuresSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string> >::type names(namesSEXP);
+    name_table_name_structures(table, structures, names);
+    return R_NilValue;
+END_RCPP
+}
+// profiler_measure
+void profiler_measure(Rcpp::XPtr<Profiler> profiler, size_t timestep, const std::string phase, const std::string name, Rcpp::Function f, size_t queued_updates);
+RcppExport SEXP _individual_profiler_measure(SEXP profilerSEXP, SEXP timestepSEXP, SEXP phaseSEXP, SEXP nameSEXP, SEXP fSEXP, SEXP queued_updatesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Profiler> >::type profiler(profilerSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timestep(timestepSEXP);
+    Rcpp::traits::input_parameter< const std::string >::type phase(phaseSEXP);
+    Rcpp::traits::input_parameter< const std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Function >::type f(fSEXP);
+    Rcpp::traits::input_parameter< size_t >::type queued_updates(queued_updatesSEXP);
+    profiler_measure(profiler, timestep, phase, name, f, queued_updates);
+    return R_NilValue;
+END_RCPP
+}
+// profiler_get_records
+Rcpp::List profiler_get_records(Rcpp::XPtr<Profiler> profiler);
+RcppExport SEXP _individual_profiler_get_records(SEXP profilerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Profiler> >::type profiler(profilerSEXP);
+    rcpp_result_gen = Rcpp::wrap(profiler_get_records(profiler));
+    return rcpp_result_gen;
+END_RCPP
+}
 // create_double_ragged_variable
 Rcpp::XPtr<RaggedDouble> create_double_ragged_variable(const std::vector<std::vector<double>>& values);
 RcppExport SEXP _individual_create_double_ragged_variable(SEXP valuesSEXP) {
@@ -1086,6 +1463,41 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// double_ragged_variable_enable_inverted_index
+void double_ragged_variable_enable_inverted_index(Rcpp::XPtr<RaggedDouble> variable);
+RcppExport SEXP _individual_double_ragged_variable_enable_inverted_index(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    double_ragged_variable_enable_inverted_index(variable);
+    return R_NilValue;
+END_RCPP
+}
+// double_ragged_variable_get_index_of_containing
+Rcpp::XPtr<individual_index_t> double_ragged_variable_get_index_of_containing(Rcpp::XPtr<RaggedDouble> variable, const std::vector<double>& values);
+RcppExport SEXP _individual_double_ragged_variable_get_index_of_containing(SEXP variableSEXP, SEXP valuesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_ragged_variable_get_index_of_containing(variable, values));
+    return rcpp_result_gen;
+END_RCPP
+}
+// double_ragged_variable_get_index_of_length_range
+Rcpp::XPtr<individual_index_t> double_ragged_variable_get_index_of_length_range(Rcpp::XPtr<RaggedDouble> variable, const size_t a, const size_t b);
+RcppExport SEXP _individual_double_ragged_variable_get_index_of_length_range(SEXP variableSEXP, SEXP aSEXP, SEXP bSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type a(aSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type b(bSEXP);
+    rcpp_result_gen = Rcpp::wrap(double_ragged_variable_get_index_of_length_range(variable, a, b));
+    return rcpp_result_gen;
+END_RCPP
+}
 // double_ragged_variable_queue_fill
 void double_ragged_variable_queue_fill(Rcpp::XPtr<RaggedDouble> variable, const std::vector<std::vector<double>>& value);
 RcppExport SEXP _individual_double_ragged_variable_queue_fill(SEXP variableSEXP, SEXP valueSEXP) {
@@ -1121,6 +1533,54 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// double_ragged_variable_queue_append
+void double_ragged_variable_queue_append(Rcpp::XPtr<RaggedDouble> variable, const std::vector<std::vector<double>>& values, std::vector<size_t> index);
+RcppExport SEXP _individual_double_ragged_variable_queue_append(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::vector<double>>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< std::vector<size_t> >::type index(indexSEXP);
+    double_ragged_variable_queue_append(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// double_ragged_variable_queue_append_bitset
+void double_ragged_variable_queue_append_bitset(Rcpp::XPtr<RaggedDouble> variable, const std::vector<std::vector<double>>& values, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_double_ragged_variable_queue_append_bitset(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::vector<double>>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    double_ragged_variable_queue_append_bitset(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// double_ragged_variable_queue_remove
+void double_ragged_variable_queue_remove(Rcpp::XPtr<RaggedDouble> variable, const std::vector<double>& values, std::vector<size_t> index);
+RcppExport SEXP _individual_double_ragged_variable_queue_remove(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< std::vector<size_t> >::type index(indexSEXP);
+    double_ragged_variable_queue_remove(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// double_ragged_variable_queue_remove_bitset
+void double_ragged_variable_queue_remove_bitset(Rcpp::XPtr<RaggedDouble> variable, const std::vector<double>& values, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_double_ragged_variable_queue_remove_bitset(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedDouble> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    double_ragged_variable_queue_remove_bitset(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
 // double_ragged_variable_queue_extend
 void double_ragged_variable_queue_extend(Rcpp::XPtr<RaggedDouble> variable, std::vector<std::vector<double>>& values);
 RcppExport SEXP _individual_double_ragged_variable_queue_extend(SEXP variableSEXP, SEXP valuesSEXP) {
@@ -1235,6 +1695,41 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// integer_ragged_variable_enable_inverted_index
+void integer_ragged_variable_enable_inverted_index(Rcpp::XPtr<RaggedInteger> variable);
+RcppExport SEXP _individual_integer_ragged_variable_enable_inverted_index(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    integer_ragged_variable_enable_inverted_index(variable);
+    return R_NilValue;
+END_RCPP
+}
+// integer_ragged_variable_get_index_of_containing
+Rcpp::XPtr<individual_index_t> integer_ragged_variable_get_index_of_containing(Rcpp::XPtr<RaggedInteger> variable, const std::vector<int>& values);
+RcppExport SEXP _individual_integer_ragged_variable_get_index_of_containing(SEXP variableSEXP, SEXP valuesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type values(valuesSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_ragged_variable_get_index_of_containing(variable, values));
+    return rcpp_result_gen;
+END_RCPP
+}
+// integer_ragged_variable_get_index_of_length_range
+Rcpp::XPtr<individual_index_t> integer_ragged_variable_get_index_of_length_range(Rcpp::XPtr<RaggedInteger> variable, const size_t a, const size_t b);
+RcppExport SEXP _individual_integer_ragged_variable_get_index_of_length_range(SEXP variableSEXP, SEXP aSEXP, SEXP bSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type a(aSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type b(bSEXP);
+    rcpp_result_gen = Rcpp::wrap(integer_ragged_variable_get_index_of_length_range(variable, a, b));
+    return rcpp_result_gen;
+END_RCPP
+}
 // integer_ragged_variable_queue_fill
 void integer_ragged_variable_queue_fill(Rcpp::XPtr<RaggedInteger> variable, const std::vector<std::vector<int>>& value);
 RcppExport SEXP _individual_integer_ragged_variable_queue_fill(SEXP variableSEXP, SEXP valueSEXP) {
@@ -1270,6 +1765,54 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// integer_ragged_variable_queue_append
+void integer_ragged_variable_queue_append(Rcpp::XPtr<RaggedInteger> variable, const std::vector<std::vector<int>>& values, std::vector<size_t> index);
+RcppExport SEXP _individual_integer_ragged_variable_queue_append(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::vector<int>>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< std::vector<size_t> >::type index(indexSEXP);
+    integer_ragged_variable_queue_append(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// integer_ragged_variable_queue_append_bitset
+void integer_ragged_variable_queue_append_bitset(Rcpp::XPtr<RaggedInteger> variable, const std::vector<std::vector<int>>& values, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_integer_ragged_variable_queue_append_bitset(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::vector<int>>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    integer_ragged_variable_queue_append_bitset(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// integer_ragged_variable_queue_remove
+void integer_ragged_variable_queue_remove(Rcpp::XPtr<RaggedInteger> variable, const std::vector<int>& values, std::vector<size_t> index);
+RcppExport SEXP _individual_integer_ragged_variable_queue_remove(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< std::vector<size_t> >::type index(indexSEXP);
+    integer_ragged_variable_queue_remove(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
+// integer_ragged_variable_queue_remove_bitset
+void integer_ragged_variable_queue_remove_bitset(Rcpp::XPtr<RaggedInteger> variable, const std::vector<int>& values, Rcpp::XPtr<individual_index_t> index);
+RcppExport SEXP _individual_integer_ragged_variable_queue_remove_bitset(SEXP variableSEXP, SEXP valuesSEXP, SEXP indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<RaggedInteger> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    integer_ragged_variable_queue_remove_bitset(variable, values, index);
+    return R_NilValue;
+END_RCPP
+}
 // integer_ragged_variable_queue_extend
 void integer_ragged_variable_queue_extend(Rcpp::XPtr<RaggedInteger> variable, std::vector<std::vector<int>>& values);
 RcppExport SEXP _individual_integer_ragged_variable_queue_extend(SEXP variableSEXP, SEXP valuesSEXP) {
@@ -1303,6 +1846,90 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// random_set_seed
+void random_set_seed(double seed);
+RcppExport SEXP _individual_random_set_seed(SEXP seedSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    random_set_seed(seed);
+    return R_NilValue;
+END_RCPP
+}
+// random_use_r
+void random_use_r();
+RcppExport SEXP _individual_random_use_r() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    random_use_r();
+    return R_NilValue;
+END_RCPP
+}
+// random_get_state
+Rcpp::XPtr<Xoshiro256> random_get_state();
+RcppExport SEXP _individual_random_get_state() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(random_get_state());
+    return rcpp_result_gen;
+END_RCPP
+}
+// random_set_state
+void random_set_state(Rcpp::XPtr<Xoshiro256> state);
+RcppExport SEXP _individual_random_set_state(SEXP stateSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Xoshiro256> >::type state(stateSEXP);
+    random_set_state(state);
+    return R_NilValue;
+END_RCPP
+}
+// random_is_native
+bool random_is_native();
+RcppExport SEXP _individual_random_is_native() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(random_is_native());
+    return rcpp_result_gen;
+END_RCPP
+}
+// create_render
+Rcpp::XPtr<Render> create_render(size_t timesteps);
+RcppExport SEXP _individual_create_render(SEXP timestepsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< size_t >::type timesteps(timestepsSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_render(timesteps));
+    return rcpp_result_gen;
+END_RCPP
+}
+// render_render
+void render_render(Rcpp::XPtr<Render> render, const std::string name, double value, size_t timestep);
+RcppExport SEXP _individual_render_render(SEXP renderSEXP, SEXP nameSEXP, SEXP valueSEXP, SEXP timestepSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Render> >::type render(renderSEXP);
+    Rcpp::traits::input_parameter< const std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< double >::type value(valueSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timestep(timestepSEXP);
+    render_render(render, name, value, timestep);
+    return R_NilValue;
+END_RCPP
+}
+// render_get_vectors
+Rcpp::List render_get_vectors(Rcpp::XPtr<Render> render);
+RcppExport SEXP _individual_render_get_vectors(SEXP renderSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Render> >::type render(renderSEXP);
+    rcpp_result_gen = Rcpp::wrap(render_get_vectors(render));
+    return rcpp_result_gen;
+END_RCPP
+}
 // execute_process
 void execute_process(Rcpp::XPtr<process_t> process, size_t timestep);
 RcppExport SEXP _individual_execute_process(SEXP processSEXP, SEXP timestepSEXP) {
@@ -1314,6 +1941,142 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// execute_declared_process
+void execute_declared_process(Rcpp::XPtr<process_t> process, size_t timestep);
+RcppExport SEXP _individual_execute_declared_process(SEXP processSEXP, SEXP timestepSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<process_t> >::type process(processSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timestep(timestepSEXP);
+    execute_declared_process(process, timestep);
+    return R_NilValue;
+END_RCPP
+}
+// simulation_loop_native
+void simulation_loop_native(const Rcpp::List variables, const Rcpp::List events, const Rcpp::List processes, const Rcpp::List populations, size_t timesteps, size_t threads, SEXP profiler, SEXP tracer);
+RcppExport SEXP _individual_simulation_loop_native(SEXP variablesSEXP, SEXP eventsSEXP, SEXP processesSEXP, SEXP populationsSEXP, SEXP timestepsSEXP, SEXP threadsSEXP, SEXP profilerSEXP, SEXP tracerSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type variables(variablesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type events(eventsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type processes(processesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type populations(populationsSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timesteps(timestepsSEXP);
+    Rcpp::traits::input_parameter< size_t >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type profiler(profilerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tracer(tracerSEXP);
+    simulation_loop_native(variables, events, processes, populations, timesteps, threads, profiler, tracer);
+    return R_NilValue;
+END_RCPP
+}
+// run_replicates_native
+void run_replicates_native(const Rcpp::List replicates, size_t timesteps, size_t threads);
+RcppExport SEXP _individual_run_replicates_native(SEXP replicatesSEXP, SEXP timestepsSEXP, SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type replicates(replicatesSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timesteps(timestepsSEXP);
+    Rcpp::traits::input_parameter< size_t >::type threads(threadsSEXP);
+    run_replicates_native(replicates, timesteps, threads);
+    return R_NilValue;
+END_RCPP
+}
+// create_thread_pool
+Rcpp::XPtr<ThreadPool> create_thread_pool(size_t threads);
+RcppExport SEXP _individual_create_thread_pool(SEXP threadsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< size_t >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_thread_pool(threads));
+    return rcpp_result_gen;
+END_RCPP
+}
+// update_and_resize_native
+void update_and_resize_native(const Rcpp::List variables, const Rcpp::List events, const Rcpp::List populations, Rcpp::XPtr<ThreadPool> pool, SEXP profiler, SEXP tracer, size_t timestep);
+RcppExport SEXP _individual_update_and_resize_native(SEXP variablesSEXP, SEXP eventsSEXP, SEXP populationsSEXP, SEXP poolSEXP, SEXP profilerSEXP, SEXP tracerSEXP, SEXP timestepSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type variables(variablesSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type events(eventsSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type populations(populationsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<ThreadPool> >::type pool(poolSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type profiler(profilerSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type tracer(tracerSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timestep(timestepSEXP);
+    update_and_resize_native(variables, events, populations, pool, profiler, tracer, timestep);
+    return R_NilValue;
+END_RCPP
+}
+// set_parallel_policy_native
+void set_parallel_policy_native(size_t threads, size_t threshold);
+RcppExport SEXP _individual_set_parallel_policy_native(SEXP threadsSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< size_t >::type threads(threadsSEXP);
+    Rcpp::traits::input_parameter< size_t >::type threshold(thresholdSEXP);
+    set_parallel_policy_native(threads, threshold);
+    return R_NilValue;
+END_RCPP
+}
+// create_time_since_variable
+Rcpp::XPtr<DoubleVariable> create_time_since_variable(const std::vector<double>& values, const double dt);
+RcppExport SEXP _individual_create_time_since_variable(SEXP valuesSEXP, SEXP dtSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< const double >::type dt(dtSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_time_since_variable(values, dt));
+    return rcpp_result_gen;
+END_RCPP
+}
+// create_tracer
+Rcpp::XPtr<Tracer> create_tracer();
+RcppExport SEXP _individual_create_tracer() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(create_tracer());
+    return rcpp_result_gen;
+END_RCPP
+}
+// tracer_trace
+void tracer_trace(Rcpp::XPtr<Tracer> tracer, size_t timestep, const std::string category, const std::string name, Rcpp::Function f);
+RcppExport SEXP _individual_tracer_trace(SEXP tracerSEXP, SEXP timestepSEXP, SEXP categorySEXP, SEXP nameSEXP, SEXP fSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Tracer> >::type tracer(tracerSEXP);
+    Rcpp::traits::input_parameter< size_t >::type timestep(timestepSEXP);
+    Rcpp::traits::input_parameter< const std::string >::type category(categorySEXP);
+    Rcpp::traits::input_parameter< const std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Function >::type f(fSEXP);
+    tracer_trace(tracer, timestep, category, name, f);
+    return R_NilValue;
+END_RCPP
+}
+// tracer_size
+size_t tracer_size(Rcpp::XPtr<Tracer> tracer);
+RcppExport SEXP _individual_tracer_size(SEXP tracerSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Tracer> >::type tracer(tracerSEXP);
+    rcpp_result_gen = Rcpp::wrap(tracer_size(tracer));
+    return rcpp_result_gen;
+END_RCPP
+}
+// tracer_write
+void tracer_write(Rcpp::XPtr<Tracer> tracer, const std::string path);
+RcppExport SEXP _individual_tracer_write(SEXP tracerSEXP, SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Tracer> >::type tracer(tracerSEXP);
+    Rcpp::traits::input_parameter< const std::string >::type path(pathSEXP);
+    tracer_write(tracer, path);
+    return R_NilValue;
+END_RCPP
+}
 // variable_get_size
 size_t variable_get_size(Rcpp::XPtr<Variable> variable);
 RcppExport SEXP _individual_variable_get_size(SEXP variableSEXP) {
@@ -1345,6 +2108,87 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// variable_enable_tombstones
+void variable_enable_tombstones(Rcpp::XPtr<Variable> variable, double threshold);
+RcppExport SEXP _individual_variable_enable_tombstones(SEXP variableSEXP, SEXP thresholdSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Variable> >::type variable(variableSEXP);
+    Rcpp::traits::input_parameter< double >::type threshold(thresholdSEXP);
+    variable_enable_tombstones(variable, threshold);
+    return R_NilValue;
+END_RCPP
+}
+// variable_get_free
+Rcpp::XPtr<individual_index_t> variable_get_free(Rcpp::XPtr<Variable> variable);
+RcppExport SEXP _individual_variable_get_free(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Variable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(variable_get_free(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
+// variable_clone
+Rcpp::XPtr<Variable> variable_clone(Rcpp::XPtr<Variable> variable);
+RcppExport SEXP _individual_variable_clone(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Variable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(variable_clone(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
+// variable_get_queue_size
+size_t variable_get_queue_size(Rcpp::XPtr<Variable> variable);
+RcppExport SEXP _individual_variable_get_queue_size(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<Variable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(variable_get_queue_size(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
+// create_weighted_sampler
+Rcpp::XPtr<WeightedSampler> create_weighted_sampler(Rcpp::XPtr<DoubleVariable> variable);
+RcppExport SEXP _individual_create_weighted_sampler(SEXP variableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<DoubleVariable> >::type variable(variableSEXP);
+    rcpp_result_gen = Rcpp::wrap(create_weighted_sampler(variable));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_sampler_sample_with_replacement
+std::vector<size_t> weighted_sampler_sample_with_replacement(Rcpp::XPtr<WeightedSampler> sampler, Rcpp::XPtr<individual_index_t> index, const size_t k);
+RcppExport SEXP _individual_weighted_sampler_sample_with_replacement(SEXP samplerSEXP, SEXP indexSEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<WeightedSampler> >::type sampler(samplerSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_sampler_sample_with_replacement(sampler, index, k));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_sampler_sample_without_replacement
+Rcpp::XPtr<individual_index_t> weighted_sampler_sample_without_replacement(Rcpp::XPtr<WeightedSampler> sampler, Rcpp::XPtr<individual_index_t> index, const size_t k);
+RcppExport SEXP _individual_weighted_sampler_sample_without_replacement(SEXP samplerSEXP, SEXP indexSEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< Rcpp::XPtr<WeightedSampler> >::type sampler(samplerSEXP);
+    Rcpp::traits::input_parameter< Rcpp::XPtr<individual_index_t> >::type index(indexSEXP);
+    Rcpp::traits::input_parameter< const size_t >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_sampler_sample_without_replacement(sampler, index, k));
+    return rcpp_result_gen;
+END_RCPP
+}
 
 // validate (ensure exported C++ functions exist before calling them)
 static int _individual_RcppExport_validate(const char* sig) { 
@@ -1365,6 +2209,14 @@ RcppExport SEXP _individual_RcppExport_registerCCallable() {
 RcppExport SEXP run_testthat_tests(SEXP);
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_individual_double_variable_summarise", (DL_FUNC) &_individual_double_variable_summarise, 2},
+    {"_individual_double_variable_summarise_by_category", (DL_FUNC) &_individual_double_variable_summarise_by_category, 4},
+    {"_individual_double_variable_summarise_by_group", (DL_FUNC) &_individual_double_variable_summarise_by_group, 4},
+    {"_individual_double_variable_histogram", (DL_FUNC) &_individual_double_variable_histogram, 5},
+    {"_individual_integer_variable_summarise", (DL_FUNC) &_individual_integer_variable_summarise, 2},
+    {"_individual_integer_variable_summarise_by_category", (DL_FUNC) &_individual_integer_variable_summarise_by_category, 4},
+    {"_individual_integer_variable_summarise_by_group", (DL_FUNC) &_individual_integer_variable_summarise_by_group, 4},
+    {"_individual_integer_variable_histogram", (DL_FUNC) &_individual_integer_variable_histogram, 5},
     {"_individual_create_bitset", (DL_FUNC) &_individual_create_bitset, 1},
     {"_individual_bitset_copy", (DL_FUNC) &_individual_bitset_copy, 1},
     {"_individual_bitset_insert", (DL_FUNC) &_individual_bitset_insert, 2},
@@ -1394,9 +2246,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_individual_categorical_variable_queue_extend", (DL_FUNC) &_individual_categorical_variable_queue_extend, 2},
     {"_individual_categorical_variable_queue_shrink", (DL_FUNC) &_individual_categorical_variable_queue_shrink, 2},
     {"_individual_categorical_variable_queue_shrink_bitset", (DL_FUNC) &_individual_categorical_variable_queue_shrink_bitset, 2},
+    {"_individual_checkpoint_save_native", (DL_FUNC) &_individual_checkpoint_save_native, 4},
+    {"_individual_checkpoint_restore_native", (DL_FUNC) &_individual_checkpoint_restore_native, 5},
     {"_individual_dummy", (DL_FUNC) &_individual_dummy, 0},
-    {"_individual_create_double_variable", (DL_FUNC) &_individual_create_double_variable, 1},
+    {"_individual_create_double_variable", (DL_FUNC) &_individual_create_double_variable, 2},
     {"_individual_double_variable_get_values", (DL_FUNC) &_individual_double_variable_get_values, 1},
+    {"_individual_double_variable_get_values_view", (DL_FUNC) &_individual_double_variable_get_values_view, 1},
     {"_individual_double_variable_get_values_at_index", (DL_FUNC) &_individual_double_variable_get_values_at_index, 2},
     {"_individual_double_variable_get_values_at_index_vector", (DL_FUNC) &_individual_double_variable_get_values_at_index_vector, 2},
     {"_individual_double_variable_get_index_of_range", (DL_FUNC) &_individual_double_variable_get_index_of_range, 3},
@@ -1429,8 +2284,13 @@ static const R_CallMethodDef CallEntries[] = {
     {"_individual_targeted_event_resize", (DL_FUNC) &_individual_targeted_event_resize, 1},
     {"_individual_process_listener", (DL_FUNC) &_individual_process_listener, 2},
     {"_individual_process_targeted_listener", (DL_FUNC) &_individual_process_targeted_listener, 3},
-    {"_individual_create_integer_variable", (DL_FUNC) &_individual_create_integer_variable, 1},
+    {"_individual_targeted_event_enable_tombstones", (DL_FUNC) &_individual_targeted_event_enable_tombstones, 2},
+    {"_individual_targeted_event_get_free", (DL_FUNC) &_individual_targeted_event_get_free, 1},
+    {"_individual_targeted_event_enable_reverse_index", (DL_FUNC) &_individual_targeted_event_enable_reverse_index, 1},
+    {"_individual_event_clone", (DL_FUNC) &_individual_event_clone, 1},
+    {"_individual_create_integer_variable", (DL_FUNC) &_individual_create_integer_variable, 2},
     {"_individual_integer_variable_get_values", (DL_FUNC) &_individual_integer_variable_get_values, 1},
+    {"_individual_integer_variable_get_values_view", (DL_FUNC) &_individual_integer_variable_get_values_view, 1},
     {"_individual_integer_variable_get_values_at_index", (DL_FUNC) &_individual_integer_variable_get_values_at_index, 2},
     {"_individual_integer_variable_get_values_at_index_vector", (DL_FUNC) &_individual_integer_variable_get_values_at_index_vector, 2},
     {"_individual_integer_variable_get_index_of_set_vector", (DL_FUNC) &_individual_integer_variable_get_index_of_set_vector, 2},
@@ -1445,10 +2305,25 @@ static const R_CallMethodDef CallEntries[] = {
     {"_individual_integer_variable_queue_extend", (DL_FUNC) &_individual_integer_variable_queue_extend, 2},
     {"_individual_integer_variable_queue_shrink", (DL_FUNC) &_individual_integer_variable_queue_shrink, 2},
     {"_individual_integer_variable_queue_shrink_bitset", (DL_FUNC) &_individual_integer_variable_queue_shrink_bitset, 2},
+    {"_individual_create_population", (DL_FUNC) &_individual_create_population, 1},
+    {"_individual_population_add_variable", (DL_FUNC) &_individual_population_add_variable, 2},
+    {"_individual_population_add_targeted_event", (DL_FUNC) &_individual_population_add_targeted_event, 2},
+    {"_individual_population_queue_shrink", (DL_FUNC) &_individual_population_queue_shrink, 2},
+    {"_individual_population_queue_shrink_bitset", (DL_FUNC) &_individual_population_queue_shrink_bitset, 2},
+    {"_individual_population_enable_tombstones", (DL_FUNC) &_individual_population_enable_tombstones, 2},
+    {"_individual_population_get_size", (DL_FUNC) &_individual_population_get_size, 1},
+    {"_individual_population_resize", (DL_FUNC) &_individual_population_resize, 1},
+    {"_individual_population_clone", (DL_FUNC) &_individual_population_clone, 3},
     {"_individual_fixed_probability_multinomial_process_internal", (DL_FUNC) &_individual_fixed_probability_multinomial_process_internal, 5},
     {"_individual_multi_probability_multinomial_process_internal", (DL_FUNC) &_individual_multi_probability_multinomial_process_internal, 5},
     {"_individual_multi_probability_bernoulli_process_internal", (DL_FUNC) &_individual_multi_probability_bernoulli_process_internal, 4},
     {"_individual_infection_age_process_internal", (DL_FUNC) &_individual_infection_age_process_internal, 9},
+    {"_individual_categorical_count_renderer_process_internal", (DL_FUNC) &_individual_categorical_count_renderer_process_internal, 3},
+    {"_individual_create_profiler", (DL_FUNC) &_individual_create_profiler, 0},
+    {"_individual_name_table_name_processes", (DL_FUNC) &_individual_name_table_name_processes, 2},
+    {"_individual_name_table_name_structures", (DL_FUNC) &_individual_name_table_name_structures, 3},
+    {"_individual_profiler_measure", (DL_FUNC) &_individual_profiler_measure, 6},
+    {"_individual_profiler_get_records", (DL_FUNC) &_individual_profiler_get_records, 1},
     {"_individual_create_double_ragged_variable", (DL_FUNC) &_individual_create_double_ragged_variable, 1},
     {"_individual_double_ragged_variable_get_values", (DL_FUNC) &_individual_double_ragged_variable_get_values, 1},
     {"_individual_double_ragged_variable_get_values_at_index_bitset", (DL_FUNC) &_individual_double_ragged_variable_get_values_at_index_bitset, 2},
@@ -1456,9 +2331,16 @@ static const R_CallMethodDef CallEntries[] = {
     {"_individual_double_ragged_variable_get_length", (DL_FUNC) &_individual_double_ragged_variable_get_length, 1},
     {"_individual_double_ragged_variable_get_length_at_index_bitset", (DL_FUNC) &_individual_double_ragged_variable_get_length_at_index_bitset, 2},
     {"_individual_double_ragged_variable_get_length_at_index_vector", (DL_FUNC) &_individual_double_ragged_variable_get_length_at_index_vector, 2},
+    {"_individual_double_ragged_variable_enable_inverted_index", (DL_FUNC) &_individual_double_ragged_variable_enable_inverted_index, 1},
+    {"_individual_double_ragged_variable_get_index_of_containing", (DL_FUNC) &_individual_double_ragged_variable_get_index_of_containing, 2},
+    {"_individual_double_ragged_variable_get_index_of_length_range", (DL_FUNC) &_individual_double_ragged_variable_get_index_of_length_range, 3},
     {"_individual_double_ragged_variable_queue_fill", (DL_FUNC) &_individual_double_ragged_variable_queue_fill, 2},
     {"_individual_double_ragged_variable_queue_update", (DL_FUNC) &_individual_double_ragged_variable_queue_update, 3},
     {"_individual_double_ragged_variable_queue_update_bitset", (DL_FUNC) &_individual_double_ragged_variable_queue_update_bitset, 3},
+    {"_individual_double_ragged_variable_queue_append", (DL_FUNC) &_individual_double_ragged_variable_queue_append, 3},
+    {"_individual_double_ragged_variable_queue_append_bitset", (DL_FUNC) &_individual_double_ragged_variable_queue_append_bitset, 3},
+    {"_individual_double_ragged_variable_queue_remove", (DL_FUNC) &_individual_double_ragged_variable_queue_remove, 3},
+    {"_individual_double_ragged_variable_queue_remove_bitset", (DL_FUNC) &_individual_double_ragged_variable_queue_remove_bitset, 3},
     {"_individual_double_ragged_variable_queue_extend", (DL_FUNC) &_individual_double_ragged_variable_queue_extend, 2},
     {"_individual_double_ragged_variable_queue_shrink", (DL_FUNC) &_individual_double_ragged_variable_queue_shrink, 2},
     {"_individual_double_ragged_variable_queue_shrink_bitset", (DL_FUNC) &_individual_double_ragged_variable_queue_shrink_bitset, 2},
@@ -1469,22 +2351,57 @@ static const R_CallMethodDef CallEntries[] = {
     {"_individual_integer_ragged_variable_get_length", (DL_FUNC) &_individual_integer_ragged_variable_get_length, 1},
     {"_individual_integer_ragged_variable_get_length_at_index_bitset", (DL_FUNC) &_individual_integer_ragged_variable_get_length_at_index_bitset, 2},
     {"_individual_integer_ragged_variable_get_length_at_index_vector", (DL_FUNC) &_individual_integer_ragged_variable_get_length_at_index_vector, 2},
+    {"_individual_integer_ragged_variable_enable_inverted_index", (DL_FUNC) &_individual_integer_ragged_variable_enable_inverted_index, 1},
+    {"_individual_integer_ragged_variable_get_index_of_containing", (DL_FUNC) &_individual_integer_ragged_variable_get_index_of_containing, 2},
+    {"_individual_integer_ragged_variable_get_index_of_length_range", (DL_FUNC) &_individual_integer_ragged_variable_get_index_of_length_range, 3},
     {"_individual_integer_ragged_variable_queue_fill", (DL_FUNC) &_individual_integer_ragged_variable_queue_fill, 2},
     {"_individual_integer_ragged_variable_queue_update", (DL_FUNC) &_individual_integer_ragged_variable_queue_update, 3},
     {"_individual_integer_ragged_variable_queue_update_bitset", (DL_FUNC) &_individual_integer_ragged_variable_queue_update_bitset, 3},
+    {"_individual_integer_ragged_variable_queue_append", (DL_FUNC) &_individual_integer_ragged_variable_queue_append, 3},
+    {"_individual_integer_ragged_variable_queue_append_bitset", (DL_FUNC) &_individual_integer_ragged_variable_queue_append_bitset, 3},
+    {"_individual_integer_ragged_variable_queue_remove", (DL_FUNC) &_individual_integer_ragged_variable_queue_remove, 3},
+    {"_individual_integer_ragged_variable_queue_remove_bitset", (DL_FUNC) &_individual_integer_ragged_variable_queue_remove_bitset, 3},
     {"_individual_integer_ragged_variable_queue_extend", (DL_FUNC) &_individual_integer_ragged_variable_queue_extend, 2},
     {"_individual_integer_ragged_variable_queue_shrink", (DL_FUNC) &_individual_integer_ragged_variable_queue_shrink, 2},
     {"_individual_integer_ragged_variable_queue_shrink_bitset", (DL_FUNC) &_individual_integer_ragged_variable_queue_shrink_bitset, 2},
+    {"_individual_random_set_seed", (DL_FUNC) &_individual_random_set_seed, 1},
+    {"_individual_random_use_r", (DL_FUNC) &_individual_random_use_r, 0},
+    {"_individual_random_get_state", (DL_FUNC) &_individual_random_get_state, 0},
+    {"_individual_random_set_state", (DL_FUNC) &_individual_random_set_state, 1},
+    {"_individual_random_is_native", (DL_FUNC) &_individual_random_is_native, 0},
+    {"_individual_create_render", (DL_FUNC) &_individual_create_render, 1},
+    {"_individual_render_render", (DL_FUNC) &_individual_render_render, 4},
+    {"_individual_render_get_vectors", (DL_FUNC) &_individual_render_get_vectors, 1},
     {"_individual_execute_process", (DL_FUNC) &_individual_execute_process, 2},
+    {"_individual_execute_declared_process", (DL_FUNC) &_individual_execute_declared_process, 2},
+    {"_individual_simulation_loop_native", (DL_FUNC) &_individual_simulation_loop_native, 8},
+    {"_individual_run_replicates_native", (DL_FUNC) &_individual_run_replicates_native, 3},
+    {"_individual_create_thread_pool", (DL_FUNC) &_individual_create_thread_pool, 1},
+    {"_individual_update_and_resize_native", (DL_FUNC) &_individual_update_and_resize_native, 7},
+    {"_individual_set_parallel_policy_native", (DL_FUNC) &_individual_set_parallel_policy_native, 2},
+    {"_individual_create_time_since_variable", (DL_FUNC) &_individual_create_time_since_variable, 2},
+    {"_individual_create_tracer", (DL_FUNC) &_individual_create_tracer, 0},
+    {"_individual_tracer_trace", (DL_FUNC) &_individual_tracer_trace, 5},
+    {"_individual_tracer_size", (DL_FUNC) &_individual_tracer_size, 1},
+    {"_individual_tracer_write", (DL_FUNC) &_individual_tracer_write, 2},
     {"_individual_variable_get_size", (DL_FUNC) &_individual_variable_get_size, 1},
     {"_individual_variable_update", (DL_FUNC) &_individual_variable_update, 1},
     {"_individual_variable_resize", (DL_FUNC) &_individual_variable_resize, 1},
+    {"_individual_variable_enable_tombstones", (DL_FUNC) &_individual_variable_enable_tombstones, 2},
+    {"_individual_variable_get_free", (DL_FUNC) &_individual_variable_get_free, 1},
+    {"_individual_variable_clone", (DL_FUNC) &_individual_variable_clone, 1},
+    {"_individual_variable_get_queue_size", (DL_FUNC) &_individual_variable_get_queue_size, 1},
+    {"_individual_create_weighted_sampler", (DL_FUNC) &_individual_create_weighted_sampler, 1},
+    {"_individual_weighted_sampler_sample_with_replacement", (DL_FUNC) &_individual_weighted_sampler_sample_with_replacement, 3},
+    {"_individual_weighted_sampler_sample_without_replacement", (DL_FUNC) &_individual_weighted_sampler_sample_without_replacement, 3},
     {"_individual_RcppExport_registerCCallable", (DL_FUNC) &_individual_RcppExport_registerCCallable, 0},
     {"run_testthat_tests", (DL_FUNC) &run_testthat_tests, 1},
     {NULL, NULL, 0}
 };
+void register_altrep_classes(DllInfo* dll);
 
 RcppExport void R_init_individual(DllInfo *dll) {
     R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
     R_useDynamicSymbols(dll, FALSE);
+    register_altrep_classes(dll);
 }
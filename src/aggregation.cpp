@@ -0,0 +1,132 @@
+/*
+ * aggregation.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+
+#include "../inst/include/aggregation.h"
+#include "../inst/include/DoubleVariable.h"
+#include "../inst/include/IntegerVariable.h"
+
+//' @title convert summaries to a list of columns for R
+//' @description mean, min and max are NA for empty summaries
+static Rcpp::List summaries_to_list(const std::vector<summary_t>& summaries) {
+    const auto n = summaries.size();
+    auto count = std::vector<double>(n);
+    auto sum = std::vector<double>(n);
+    auto mean = std::vector<double>(n);
+    auto min = std::vector<double>(n);
+    auto max = std::vector<double>(n);
+    for (auto i = 0u; i < n; ++i) {
+        const auto& s = summaries[i];
+        count[i] = s.count;
+        sum[i] = s.sum;
+        mean[i] = s.count > 0 ? s.mean() : NA_REAL;
+        min[i] = s.count > 0 ? s.min : NA_REAL;
+        max[i] = s.count > 0 ? s.max : NA_REAL;
+    }
+    return Rcpp::List::create(
+        Rcpp::Named("count") = count,
+        Rcpp::Named("sum") = sum,
+        Rcpp::Named("mean") = mean,
+        Rcpp::Named("min") = min,
+        Rcpp::Named("max") = max
+    );
+}
+
+//[[Rcpp::export]]
+Rcpp::List double_variable_summarise(
+    Rcpp::XPtr<DoubleVariable> variable,
+    Rcpp::XPtr<individual_index_t> index
+    ) {
+    auto view = variable->get_values_view();
+    return summaries_to_list({ summarise_values(*view, *index) });
+}
+
+//[[Rcpp::export]]
+Rcpp::List double_variable_summarise_by_category(
+    Rcpp::XPtr<DoubleVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    Rcpp::XPtr<CategoricalVariable> by,
+    const std::vector<std::string> categories
+    ) {
+    auto view = variable->get_values_view();
+    return summaries_to_list(
+        summarise_values_by_category(*view, *index, *by, categories)
+    );
+}
+
+//[[Rcpp::export]]
+Rcpp::List double_variable_summarise_by_group(
+    Rcpp::XPtr<DoubleVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    Rcpp::XPtr<IntegerVariable> by,
+    const std::vector<int> groups
+    ) {
+    auto view = variable->get_values_view();
+    auto group_values = by->get_values_view();
+    return summaries_to_list(
+        summarise_values_by_group(*view, *index, *group_values, groups)
+    );
+}
+
+//[[Rcpp::export]]
+std::vector<size_t> double_variable_histogram(
+    Rcpp::XPtr<DoubleVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    const double lower,
+    const double upper,
+    const size_t n_bins
+    ) {
+    auto view = variable->get_values_view();
+    return histogram_values(*view, *index, lower, upper, n_bins);
+}
+
+//[[Rcpp::export]]
+Rcpp::List integer_variable_summarise(
+    Rcpp::XPtr<IntegerVariable> variable,
+    Rcpp::XPtr<individual_index_t> index
+    ) {
+    auto view = variable->get_values_view();
+    return summaries_to_list({ summarise_values(*view, *index) });
+}
+
+//[[Rcpp::export]]
+Rcpp::List integer_variable_summarise_by_category(
+    Rcpp::XPtr<IntegerVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    Rcpp::XPtr<CategoricalVariable> by,
+    const std::vector<std::string> categories
+    ) {
+    auto view = variable->get_values_view();
+    return summaries_to_list(
+        summarise_values_by_category(*view, *index, *by, categories)
+    );
+}
+
+//[[Rcpp::export]]
+Rcpp::List integer_variable_summarise_by_group(
+    Rcpp::XPtr<IntegerVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    Rcpp::XPtr<IntegerVariable> by,
+    const std::vector<int> groups
+    ) {
+    auto view = variable->get_values_view();
+    auto group_values = by->get_values_view();
+    return summaries_to_list(
+        summarise_values_by_group(*view, *index, *group_values, groups)
+    );
+}
+
+//[[Rcpp::export]]
+std::vector<size_t> integer_variable_histogram(
+    Rcpp::XPtr<IntegerVariable> variable,
+    Rcpp::XPtr<individual_index_t> index,
+    const double lower,
+    const double upper,
+    const size_t n_bins
+    ) {
+    auto view = variable->get_values_view();
+    return histogram_values(*view, *index, lower, upper, n_bins);
+}
@@ -0,0 +1,190 @@
+/*
+ * altrep.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *
+ *  ALTREP vectors backed by variable views, so that R can read a variable's
+ *  values without copying them.
+ */
+
+#include "altrep.h"
+
+#if defined(R_VERSION)
+#if R_VERSION >= R_Version(3, 6, 0)
+#define INDIVIDUAL_ALTREP
+#include <R_ext/Altrep.h>
+#endif
+#endif
+
+#ifdef INDIVIDUAL_ALTREP
+
+template<class A>
+struct altrep_traits;
+
+template<>
+struct altrep_traits<double> {
+    static constexpr SEXPTYPE type = REALSXP;
+    static double* pointer(SEXP x) { return REAL(x); }
+};
+
+template<>
+struct altrep_traits<int> {
+    static constexpr SEXPTYPE type = INTSXP;
+    static int* pointer(SEXP x) { return INTEGER(x); }
+};
+
+//' @title an ALTREP class for views of type A
+//' @description data1 holds the view, data2 holds a materialised copy of the
+//' values once R asks for a writeable pointer or the view has no contiguous
+//' storage.
+template<class A>
+struct AltrepView {
+    using view_ptr_t = std::shared_ptr<ValuesView<A>>;
+
+    static R_altrep_class_t altrep_class;
+
+    static SEXP make(const view_ptr_t& view) {
+        auto ptr = Rcpp::XPtr<view_ptr_t>(new view_ptr_t(view), true);
+        return R_new_altrep(altrep_class, ptr, R_NilValue);
+    }
+
+    static const ValuesView<A>& view(SEXP x) {
+        return **Rcpp::XPtr<view_ptr_t>(R_altrep_data1(x));
+    }
+
+    static SEXP materialise(SEXP x) {
+        auto data = R_altrep_data2(x);
+        if (data == R_NilValue) {
+            const auto& values = view(x);
+            data = PROTECT(Rf_allocVector(altrep_traits<A>::type, values.size()));
+            auto result = altrep_traits<A>::pointer(data);
+            for (auto i = 0u; i < values.size(); ++i) {
+                result[i] = values.at(i);
+            }
+            R_set_altrep_data2(x, data);
+            UNPROTECT(1);
+        }
+        return data;
+    }
+
+    static R_xlen_t length(SEXP x) {
+        return view(x).size();
+    }
+
+    static Rboolean inspect(
+        SEXP x,
+        int pre,
+        int deep,
+        int pvec,
+        void (*inspect_subtree)(SEXP, int, int, int)
+    ) {
+        Rprintf(
+            "individual values view (len=%td, materialised=%s)\n",
+            static_cast<ptrdiff_t>(length(x)),
+            R_altrep_data2(x) == R_NilValue ? "F" : "T"
+        );
+        return TRUE;
+    }
+
+    static void* dataptr(SEXP x, Rboolean writeable) {
+        if (R_altrep_data2(x) == R_NilValue && !writeable) {
+            auto data = view(x).data();
+            if (data != nullptr) {
+                return const_cast<A*>(data);
+            }
+        }
+        return altrep_traits<A>::pointer(materialise(x));
+    }
+
+    static const void* dataptr_or_null(SEXP x) {
+        auto data = R_altrep_data2(x);
+        if (data != R_NilValue) {
+            return altrep_traits<A>::pointer(data);
+        }
+        return view(x).data();
+    }
+
+    static A elt(SEXP x, R_xlen_t i) {
+        auto data = R_altrep_data2(x);
+        if (data != R_NilValue) {
+            return altrep_traits<A>::pointer(data)[i];
+        }
+        return view(x).at(i);
+    }
+
+    static R_xlen_t get_region(SEXP x, R_xlen_t start, R_xlen_t size, A* out) {
+        const auto n = std::min(size, length(x) - start);
+        for (R_xlen_t i = 0; i < n; ++i) {
+            out[i] = elt(x, start + i);
+        }
+        return n;
+    }
+
+    static void register_methods() {
+        R_set_altrep_Length_method(altrep_class, length);
+        R_set_altrep_Inspect_method(altrep_class, inspect);
+        R_set_altvec_Dataptr_method(altrep_class, dataptr);
+        R_set_altvec_Dataptr_or_null_method(altrep_class, dataptr_or_null);
+    }
+};
+
+template<class A>
+R_altrep_class_t AltrepView<A>::altrep_class;
+
+static void register_altrep_views(DllInfo* dll) {
+    AltrepView<double>::altrep_class = R_make_altreal_class(
+        "values_view_double",
+        "individual",
+        dll
+    );
+    AltrepView<double>::register_methods();
+    R_set_altreal_Elt_method(AltrepView<double>::altrep_class, AltrepView<double>::elt);
+    R_set_altreal_Get_region_method(AltrepView<double>::altrep_class, AltrepView<double>::get_region);
+
+    AltrepView<int>::altrep_class = R_make_altinteger_class(
+        "values_view_int",
+        "individual",
+        dll
+    );
+    AltrepView<int>::register_methods();
+    R_set_altinteger_Elt_method(AltrepView<int>::altrep_class, AltrepView<int>::elt);
+    R_set_altinteger_Get_region_method(AltrepView<int>::altrep_class, AltrepView<int>::get_region);
+}
+
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<double>>& view) {
+    return AltrepView<double>::make(view);
+}
+
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<int>>& view) {
+    return AltrepView<int>::make(view);
+}
+
+#else
+
+// ALTREP is not available, so views are copied into ordinary vectors
+
+template<class A>
+inline std::vector<A> copy_view(const ValuesView<A>& view) {
+    auto result = std::vector<A>(view.size());
+    for (auto i = 0u; i < view.size(); ++i) {
+        result[i] = view.at(i);
+    }
+    return result;
+}
+
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<double>>& view) {
+    return Rcpp::wrap(copy_view(*view));
+}
+
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<int>>& view) {
+    return Rcpp::wrap(copy_view(*view));
+}
+
+#endif
+
+// [[Rcpp::init]]
+void register_altrep_classes(DllInfo* dll) {
+#ifdef INDIVIDUAL_ALTREP
+    register_altrep_views(dll);
+#endif
+}
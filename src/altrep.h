@@ -0,0 +1,16 @@
+/*
+ * altrep.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef SRC_ALTREP_H_
+#define SRC_ALTREP_H_
+
+#include "../inst/include/ValuesView.h"
+#include <Rcpp.h>
+
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<double>>& view);
+SEXP make_altrep_view(const std::shared_ptr<ValuesView<int>>& view);
+
+#endif /* SRC_ALTREP_H_ */
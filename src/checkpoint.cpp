@@ -0,0 +1,80 @@
+/*
+ * checkpoint.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "../inst/include/Checkpoint.h"
+#include "../inst/include/Population.h"
+#include "../inst/include/Random.h"
+
+//[[Rcpp::export]]
+void checkpoint_save_native(
+    const std::string path,
+    const Rcpp::List variables,
+    const Rcpp::List events,
+    const Rcpp::List populations
+    ) {
+    CheckpointWriter out(path);
+    out.write(static_cast<uint64_t>(variables.size()));
+    for (auto i = 0; i < variables.size(); ++i) {
+        Rcpp::XPtr<Variable>(SEXP(variables[i]))->save(out);
+    }
+    out.write(static_cast<uint64_t>(events.size()));
+    for (auto i = 0; i < events.size(); ++i) {
+        Rcpp::XPtr<EventBase>(SEXP(events[i]))->save(out);
+    }
+    out.write(static_cast<uint64_t>(populations.size()));
+    for (auto i = 0; i < populations.size(); ++i) {
+        Rcpp::XPtr<Population>(SEXP(populations[i]))->save(out);
+    }
+    out.write_tag("Random");
+    out.write(static_cast<uint8_t>(native_random()));
+    out.write(get_random_state());
+    out.close();
+}
+
+//' @title check that a checkpoint has as many structures as are restored
+void expect_count(CheckpointReader& in, size_t expected, const std::string& what) {
+    auto count = uint64_t(0);
+    in.read(count);
+    if (count != expected) {
+        Rcpp::stop(
+            "checkpoint has " + std::to_string(count) + " " + what +
+            " but " + std::to_string(expected) + " were given"
+        );
+    }
+}
+
+//[[Rcpp::export]]
+bool checkpoint_restore_native(
+    const std::string path,
+    const Rcpp::List variables,
+    const Rcpp::List events,
+    const Rcpp::List populations,
+    bool restore_random
+    ) {
+    CheckpointReader in(path);
+    expect_count(in, variables.size(), "variables");
+    for (auto i = 0; i < variables.size(); ++i) {
+        Rcpp::XPtr<Variable>(SEXP(variables[i]))->load(in);
+    }
+    expect_count(in, events.size(), "events");
+    for (auto i = 0; i < events.size(); ++i) {
+        Rcpp::XPtr<EventBase>(SEXP(events[i]))->load(in);
+    }
+    expect_count(in, populations.size(), "populations");
+    for (auto i = 0; i < populations.size(); ++i) {
+        Rcpp::XPtr<Population>(SEXP(populations[i]))->load(in);
+    }
+    in.expect_tag("Random");
+    auto native = uint8_t(0);
+    in.read(native);
+    auto state = Xoshiro256(0);
+    in.read(state);
+    in.close();
+    if (restore_random && native) {
+        set_random_state(state);
+    }
+    return native;
+}
@@ -7,16 +7,28 @@
 
 
 #include "../inst/include/DoubleVariable.h"
+#include "../inst/include/CompactVariable.h"
 #include "utils.h"
+#include "altrep.h"
 
 //[[Rcpp::export]]
 Rcpp::XPtr<DoubleVariable> create_double_variable(
-    const std::vector<double>& values
+    const std::vector<double>& values,
+    const std::string storage
     ) {
-    return Rcpp::XPtr<DoubleVariable>(
-        new DoubleVariable(values),
-        true
-    );
+    if (storage == "double") {
+        return Rcpp::XPtr<DoubleVariable>(
+            new DoubleVariable(values),
+            true
+        );
+    }
+    if (storage == "float") {
+        return Rcpp::XPtr<DoubleVariable>(
+            new CompactDoubleVariable<float>(values),
+            true
+        );
+    }
+    Rcpp::stop("unknown storage type for DoubleVariable: " + storage);
 }
 
 //[[Rcpp::export]]
@@ -26,6 +38,13 @@ std::vector<double> double_variable_get_values(
     return variable->get_values();
 }
 
+//[[Rcpp::export]]
+SEXP double_variable_get_values_view(
+    Rcpp::XPtr<DoubleVariable> variable
+    ) {
+    return make_altrep_view(variable->get_values_view());
+}
+
 //[[Rcpp::export]]
 std::vector<double> double_variable_get_values_at_index(
     Rcpp::XPtr<DoubleVariable> variable,
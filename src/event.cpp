@@ -39,9 +39,7 @@ void targeted_event_clear_schedule_vector(
     std::vector<size_t> target
     ) {
     decrement(target);
-    auto bitmap = individual_index_t(event->size());
-    bitmap.insert_safe(target.cbegin(), target.cend());
-    event->clear_schedule(bitmap);
+    event->clear_schedule(target);
 }
 
 //[[Rcpp::export]]
@@ -188,3 +186,34 @@ void process_targeted_listener(
     size_t t = event->get_time();
     (*listener)(t, *target.get());
 }
+
+//[[Rcpp::export]]
+void targeted_event_enable_tombstones(
+    const Rcpp::XPtr<TargetedEvent> event,
+    double threshold
+    ) {
+    event->enable_tombstones(threshold);
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<individual_index_t> targeted_event_get_free(
+    const Rcpp::XPtr<TargetedEvent> event
+    ) {
+    const auto& tombstones = event->get_tombstones();
+    return Rcpp::XPtr<individual_index_t>(
+        tombstones.enabled() ?
+            new individual_index_t(tombstones.get_free()) :
+            new individual_index_t(event->size()),
+        true
+    );
+}
+
+//[[Rcpp::export]]
+void targeted_event_enable_reverse_index(const Rcpp::XPtr<TargetedEvent> event) {
+    event->enable_reverse_index();
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<EventBase> event_clone(const Rcpp::XPtr<EventBase> event) {
+    return Rcpp::XPtr<EventBase>(event->clone(), true);
+}
@@ -7,16 +7,28 @@
 
 
 #include "../inst/include/IntegerVariable.h"
+#include "../inst/include/CompactVariable.h"
 #include "utils.h"
+#include "altrep.h"
 
 //[[Rcpp::export]]
 Rcpp::XPtr<IntegerVariable> create_integer_variable(
-    const std::vector<int>& values
+    const std::vector<int>& values,
+    const std::string storage
     ) {
-    return Rcpp::XPtr<IntegerVariable>(
-        new IntegerVariable(values),
-        true
-    );
+    IntegerVariable* variable;
+    if (storage == "int") {
+        variable = new IntegerVariable(values);
+    } else if (storage == "int16") {
+        variable = new CompactIntegerVariable<int16_t>(values);
+    } else if (storage == "int8") {
+        variable = new CompactIntegerVariable<int8_t>(values);
+    } else if (storage == "uint8") {
+        variable = new CompactIntegerVariable<uint8_t>(values);
+    } else {
+        Rcpp::stop("unknown storage type for IntegerVariable: " + storage);
+    }
+    return Rcpp::XPtr<IntegerVariable>(variable, true);
 }
 
 //[[Rcpp::export]]
@@ -26,6 +38,13 @@ std::vector<int> integer_variable_get_values(
     return variable->get_values();
 }
 
+//[[Rcpp::export]]
+SEXP integer_variable_get_values_view(
+    Rcpp::XPtr<IntegerVariable> variable
+    ) {
+    return make_altrep_view(variable->get_values_view());
+}
+
 //[[Rcpp::export]]
 std::vector<int> integer_variable_get_values_at_index(
     Rcpp::XPtr<IntegerVariable> variable,
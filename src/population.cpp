@@ -0,0 +1,84 @@
+/*
+ * population.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "../inst/include/Population.h"
+#include "utils.h"
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Population> create_population(size_t size) {
+    return Rcpp::XPtr<Population>(new Population(size), true);
+}
+
+//[[Rcpp::export]]
+void population_add_variable(
+    Rcpp::XPtr<Population> population,
+    Rcpp::XPtr<Variable> variable
+    ) {
+    population->add_variable(variable.get());
+}
+
+//[[Rcpp::export]]
+void population_add_targeted_event(
+    Rcpp::XPtr<Population> population,
+    Rcpp::XPtr<TargetedEvent> event
+    ) {
+    population->add_event(event.get());
+}
+
+//[[Rcpp::export]]
+void population_queue_shrink(
+    Rcpp::XPtr<Population> population,
+    std::vector<size_t>& index
+    ) {
+    decrement(index);
+    population->queue_shrink(index);
+}
+
+//[[Rcpp::export]]
+void population_queue_shrink_bitset(
+    Rcpp::XPtr<Population> population,
+    Rcpp::XPtr<individual_index_t> index
+    ) {
+    population->queue_shrink(*index);
+}
+
+//[[Rcpp::export]]
+void population_enable_tombstones(
+    Rcpp::XPtr<Population> population,
+    double threshold
+    ) {
+    population->enable_tombstones(threshold);
+}
+
+//[[Rcpp::export]]
+size_t population_get_size(Rcpp::XPtr<Population> population) {
+    return population->size();
+}
+
+//[[Rcpp::export]]
+void population_resize(Rcpp::XPtr<Population> population) {
+    population->resize();
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Population> population_clone(
+    Rcpp::XPtr<Population> population,
+    const Rcpp::List variables,
+    const Rcpp::List events
+    ) {
+    auto new_variables = std::vector<Variable*>();
+    for (auto i = 0; i < variables.size(); ++i) {
+        new_variables.push_back(Rcpp::XPtr<Variable>(SEXP(variables[i])).get());
+    }
+    auto new_events = std::vector<TargetedEvent*>();
+    for (auto i = 0; i < events.size(); ++i) {
+        new_events.push_back(Rcpp::XPtr<TargetedEvent>(SEXP(events[i])).get());
+    }
+    return Rcpp::XPtr<Population>(
+        population->clone(new_variables, new_events),
+        true
+    );
+}
@@ -8,6 +8,7 @@
 #include "../inst/include/DoubleVariable.h"
 #include "../inst/include/CategoricalVariable.h"
 #include "../inst/include/IntegerVariable.h"
+#include "../inst/include/Render.h"
 #include "utils.h"
 
 
@@ -39,7 +40,7 @@ Rcpp::XPtr<process_t> fixed_probability_multinomial_process_internal(
             }
 
             // random variate for each leaver to see where they go
-            const auto random = Rcpp::runif(leaving_individuals.size());
+            const auto random = random_uniform(leaving_individuals.size());
             auto random_index = 0;
             for (auto it = std::begin(leaving_individuals); it != std::end(leaving_individuals); ++it) {
                 auto dest_it = std::upper_bound(cdf.begin(), cdf.end(), random[random_index]);
@@ -88,7 +89,7 @@ Rcpp::XPtr<process_t> multi_probability_multinomial_process_internal(
             }
 
             // random variate for each leaver to see where they go
-            const auto random = Rcpp::runif(leaving_individuals.size());
+            const auto random = random_uniform(leaving_individuals.size());
             auto random_index = 0;
             for (auto it = std::begin(leaving_individuals); it != std::end(leaving_individuals); ++it) {
                 auto dest_it = std::upper_bound(cdf.begin(), cdf.end(), random[random_index]);
@@ -178,3 +179,20 @@ Rcpp::XPtr<process_t> infection_age_process_internal(
         true
     );
 }
+
+// [[Rcpp::export]]
+Rcpp::XPtr<process_t> categorical_count_renderer_process_internal(
+    Rcpp::XPtr<Render> renderer,
+    Rcpp::XPtr<CategoricalVariable> variable,
+    const std::vector<std::string> categories
+) {
+    // make pointer to lambda function and return XPtr to R
+    return Rcpp::XPtr<process_t>(
+        new process_t([renderer,variable,categories](size_t t){
+            for (const auto& category : categories) {
+                renderer->render(category + "_count", variable->get_size_of(category), t);
+            }
+        }),
+        true
+    );
+}
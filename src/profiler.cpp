@@ -0,0 +1,73 @@
+/*
+ * profiler.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "../inst/include/Profiler.h"
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Profiler> create_profiler() {
+    return Rcpp::XPtr<Profiler>(new Profiler(), true);
+}
+
+//[[Rcpp::export]]
+void name_table_name_processes(
+    Rcpp::XPtr<NameTable> table,
+    const std::vector<std::string> names
+    ) {
+    table->name_processes(names);
+}
+
+//[[Rcpp::export]]
+void name_table_name_structures(
+    Rcpp::XPtr<NameTable> table,
+    const Rcpp::List structures,
+    const std::vector<std::string> names
+    ) {
+    if (static_cast<size_t>(structures.size()) != names.size()) {
+        Rcpp::stop("each structure needs a name");
+    }
+    for (auto i = 0u; i < names.size(); ++i) {
+        table->name_structure(R_ExternalPtrAddr(structures[i]), names[i]);
+    }
+}
+
+//[[Rcpp::export]]
+void profiler_measure(
+    Rcpp::XPtr<Profiler> profiler,
+    size_t timestep,
+    const std::string phase,
+    const std::string name,
+    Rcpp::Function f,
+    size_t queued_updates
+    ) {
+    profiler->measure(timestep, phase, name, [&f]() { f(); }, queued_updates);
+}
+
+//[[Rcpp::export]]
+Rcpp::List profiler_get_records(Rcpp::XPtr<Profiler> profiler) {
+    const auto& records = profiler->get_records();
+    auto timestep = Rcpp::NumericVector(records.size());
+    auto phase = Rcpp::CharacterVector(records.size());
+    auto name = Rcpp::CharacterVector(records.size());
+    auto seconds = Rcpp::NumericVector(records.size());
+    auto queued_updates = Rcpp::NumericVector(records.size());
+    auto bitset_allocations = Rcpp::NumericVector(records.size());
+    for (auto i = 0u; i < records.size(); ++i) {
+        timestep[i] = records[i].timestep;
+        phase[i] = records[i].phase;
+        name[i] = records[i].name;
+        seconds[i] = records[i].seconds;
+        queued_updates[i] = records[i].queued_updates;
+        bitset_allocations[i] = records[i].bitset_allocations;
+    }
+    return Rcpp::List::create(
+        Rcpp::Named("timestep") = timestep,
+        Rcpp::Named("phase") = phase,
+        Rcpp::Named("name") = name,
+        Rcpp::Named("seconds") = seconds,
+        Rcpp::Named("queued_updates") = queued_updates,
+        Rcpp::Named("bitset_allocations") = bitset_allocations
+    );
+}
@@ -67,6 +67,36 @@ std::vector<size_t> double_ragged_variable_get_length_at_index_vector(
   return variable->get_length(index);
 }
 
+//[[Rcpp::export]]
+void double_ragged_variable_enable_inverted_index(
+    Rcpp::XPtr<RaggedDouble> variable
+) {
+  variable->enable_inverted_index();
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<individual_index_t> double_ragged_variable_get_index_of_containing(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const std::vector<double>& values
+) {
+  return Rcpp::XPtr<individual_index_t>(
+    new individual_index_t(variable->get_index_of_containing(values)),
+    true
+  );
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<individual_index_t> double_ragged_variable_get_index_of_length_range(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const size_t a,
+    const size_t b
+) {
+  return Rcpp::XPtr<individual_index_t>(
+    new individual_index_t(variable->get_index_of_length_range(a, b)),
+    true
+  );
+}
+
 //[[Rcpp::export]]
 void double_ragged_variable_queue_fill(
     Rcpp::XPtr<RaggedDouble> variable,
@@ -98,6 +128,50 @@ void double_ragged_variable_queue_update_bitset(
   variable->queue_update(value, index_vec);
 }
 
+//[[Rcpp::export]]
+void double_ragged_variable_queue_append(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const std::vector<std::vector<double>>& values,
+    std::vector<size_t> index
+) {
+  decrement(index);
+  variable->queue_append(values, index);
+}
+
+//[[Rcpp::export]]
+void double_ragged_variable_queue_append_bitset(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const std::vector<std::vector<double>>& values,
+    Rcpp::XPtr<individual_index_t> index
+) {
+  if (index->max_size() != variable->size()) {
+    Rcpp::stop("incompatible size bitset used to queue append for RaggedDouble");
+  }
+  variable->queue_append(values, bitset_to_vector_internal(*index, false));
+}
+
+//[[Rcpp::export]]
+void double_ragged_variable_queue_remove(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const std::vector<double>& values,
+    std::vector<size_t> index
+) {
+  decrement(index);
+  variable->queue_remove(values, index);
+}
+
+//[[Rcpp::export]]
+void double_ragged_variable_queue_remove_bitset(
+    Rcpp::XPtr<RaggedDouble> variable,
+    const std::vector<double>& values,
+    Rcpp::XPtr<individual_index_t> index
+) {
+  if (index->max_size() != variable->size()) {
+    Rcpp::stop("incompatible size bitset used to queue remove for RaggedDouble");
+  }
+  variable->queue_remove(values, bitset_to_vector_internal(*index, false));
+}
+
 //[[Rcpp::export]]
 void double_ragged_variable_queue_extend(
     Rcpp::XPtr<RaggedDouble> variable,
@@ -0,0 +1,33 @@
+/*
+ * random.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+
+#include "../inst/include/Random.h"
+
+//[[Rcpp::export]]
+void random_set_seed(double seed) {
+    set_random_seed(static_cast<uint64_t>(seed));
+}
+
+//[[Rcpp::export]]
+void random_use_r() {
+    use_r_random();
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Xoshiro256> random_get_state() {
+    return Rcpp::XPtr<Xoshiro256>(new Xoshiro256(get_random_state()), true);
+}
+
+//[[Rcpp::export]]
+void random_set_state(Rcpp::XPtr<Xoshiro256> state) {
+    set_random_state(*state);
+}
+
+//[[Rcpp::export]]
+bool random_is_native() {
+    return native_random();
+}
@@ -0,0 +1,34 @@
+/*
+ * render.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "../inst/include/Render.h"
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Render> create_render(size_t timesteps) {
+    return Rcpp::XPtr<Render>(new Render(timesteps), true);
+}
+
+//[[Rcpp::export]]
+void render_render(
+    Rcpp::XPtr<Render> render,
+    const std::string name,
+    double value,
+    size_t timestep
+    ) {
+    render->render(name, value, timestep);
+}
+
+//[[Rcpp::export]]
+Rcpp::List render_get_vectors(Rcpp::XPtr<Render> render) {
+    const auto& names = render->get_names();
+    auto result = Rcpp::List(names.size());
+    for (auto i = 0u; i < names.size(); ++i) {
+        const auto& values = render->get_values(names[i]);
+        result[i] = Rcpp::NumericVector(values.cbegin(), values.cend());
+    }
+    result.names() = Rcpp::CharacterVector(names.cbegin(), names.cend());
+    return result;
+}
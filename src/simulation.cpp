@@ -6,9 +6,230 @@
  */
 
 #include "../inst/include/common_types.h"
+#include "../inst/include/Simulation.h"
 #include <Rcpp.h>
 
 //[[Rcpp::export]]
 void execute_process(Rcpp::XPtr<process_t> process, size_t timestep) {
     (*process)(timestep);
 }
+
+//[[Rcpp::export]]
+void execute_declared_process(Rcpp::XPtr<process_t> process, size_t timestep) {
+    auto buffer = staged_changes_t();
+    {
+        StagingScope scope(buffer);
+        (*process)(timestep);
+    }
+    apply_staged_changes(buffer);
+}
+
+//' @title a process which is either a C++ process or an R function
+process_t as_process(SEXP process) {
+    if (TYPEOF(process) == EXTPTRSXP) {
+        const auto native = Rcpp::XPtr<process_t>(process);
+        return [native](size_t t) { (*native)(t); };
+    }
+    const auto function = Rcpp::Function(process);
+    return [function](size_t t) { function(t); };
+}
+
+//' @title the addresses of a list of structures' external pointers
+std::vector<const void*> as_addresses(const Rcpp::List& structures) {
+    auto addresses = std::vector<const void*>();
+    for (auto i = 0; i < structures.size(); ++i) {
+        addresses.push_back(R_ExternalPtrAddr(structures[i]));
+    }
+    return addresses;
+}
+
+//' @title a listener which is either a C++ listener or an R function
+//' @description R functions take no arguments and get the timestep and target
+//' from the event themselves
+template<class Listener, class F>
+std::vector<listener_t> as_listeners(const Rcpp::List& listeners, F call_native) {
+    auto result = std::vector<listener_t>();
+    for (auto i = 0; i < listeners.size(); ++i) {
+        SEXP listener = listeners[i];
+        if (TYPEOF(listener) == EXTPTRSXP) {
+            const auto native = Rcpp::XPtr<Listener>(listener);
+            result.push_back([native, call_native](size_t t) {
+                call_native(*native, t);
+            });
+        } else {
+            const auto function = Rcpp::Function(listener);
+            result.push_back([function](size_t) { function(); });
+        }
+    }
+    return result;
+}
+
+//' @title add the structures and processes in R lists to a simulation
+void add_to_simulation(
+    Simulation& simulation,
+    const Rcpp::List& variables,
+    const Rcpp::List& events,
+    const Rcpp::List& processes,
+    const Rcpp::List& populations
+    ) {
+    for (auto i = 0; i < processes.size(); ++i) {
+        SEXP process = processes[i];
+        if (TYPEOF(process) == VECSXP) {
+            // a C++ process which has declared what it accesses
+            const auto declared = Rcpp::List(process);
+            auto access = ProcessAccess();
+            access.declared = true;
+            access.reads = as_addresses(Rcpp::List(declared["reads"]));
+            access.writes = as_addresses(Rcpp::List(declared["writes"]));
+            simulation.add_process(as_process(declared["process"]), access);
+        } else {
+            simulation.add_process(as_process(process));
+        }
+    }
+    for (auto i = 0; i < events.size(); ++i) {
+        const auto event = Rcpp::List(events[i]);
+        const auto listeners = Rcpp::List(event["listeners"]);
+        if (Rcpp::as<bool>(event["targeted"])) {
+            const auto targeted = Rcpp::XPtr<TargetedEvent>(SEXP(event["event"]));
+            simulation.add_event(
+                targeted.get(),
+                as_listeners<targeted_listener_t>(
+                    listeners,
+                    [targeted](targeted_listener_t& listener, size_t t) {
+                        listener(t, targeted->current_target());
+                    }
+                )
+            );
+        } else {
+            simulation.add_event(
+                Rcpp::XPtr<EventBase>(SEXP(event["event"])).get(),
+                as_listeners<listener_t>(
+                    listeners,
+                    [](listener_t& listener, size_t t) { listener(t); }
+                )
+            );
+        }
+    }
+    for (auto i = 0; i < variables.size(); ++i) {
+        simulation.add_variable(Rcpp::XPtr<Variable>(SEXP(variables[i])).get());
+    }
+    for (auto i = 0; i < populations.size(); ++i) {
+        simulation.add_population(Rcpp::XPtr<Population>(SEXP(populations[i])).get());
+    }
+}
+
+//' @title the profiler to measure a simulation with, or nullptr
+//' @param profiler a Profiler's external pointer, or NULL
+Profiler* as_profiler(SEXP profiler) {
+    if (TYPEOF(profiler) == EXTPTRSXP) {
+        return Rcpp::XPtr<Profiler>(profiler).get();
+    }
+    return nullptr;
+}
+
+//' @title the tracer to record a simulation with, or nullptr
+//' @param tracer a Tracer's external pointer, or NULL
+Tracer* as_tracer(SEXP tracer) {
+    if (TYPEOF(tracer) == EXTPTRSXP) {
+        return Rcpp::XPtr<Tracer>(tracer).get();
+    }
+    return nullptr;
+}
+
+//[[Rcpp::export]]
+void simulation_loop_native(
+    const Rcpp::List variables,
+    const Rcpp::List events,
+    const Rcpp::List processes,
+    const Rcpp::List populations,
+    size_t timesteps,
+    size_t threads,
+    SEXP profiler,
+    SEXP tracer
+    ) {
+    auto simulation = Simulation();
+    simulation.set_threads(threads);
+    simulation.set_profiler(as_profiler(profiler));
+    simulation.set_tracer(as_tracer(tracer));
+    add_to_simulation(simulation, variables, events, processes, populations);
+    simulation.run(timesteps);
+}
+
+//[[Rcpp::export]]
+void run_replicates_native(
+    const Rcpp::List replicates,
+    size_t timesteps,
+    size_t threads
+    ) {
+    if (!native_random()) {
+        Rcpp::stop("replicates need the native random number generator, see set_native_seed");
+    }
+    auto simulations = std::vector<std::unique_ptr<Simulation>>();
+    auto streams = std::vector<Xoshiro256>();
+    for (auto i = 0; i < replicates.size(); ++i) {
+        const auto replicate = Rcpp::List(replicates[i]);
+        simulations.emplace_back(new Simulation());
+        add_to_simulation(
+            *simulations.back(),
+            Rcpp::List(replicate["variables"]),
+            Rcpp::List(replicate["events"]),
+            Rcpp::List(replicate["processes"]),
+            Rcpp::List(replicate["populations"])
+        );
+        // streams are made here, in order, so they do not depend on which
+        // thread runs each replicate
+        simulations.back()->make_random_streams();
+        streams.push_back(new_random_stream());
+    }
+    auto tasks = std::vector<std::function<void ()>>();
+    for (auto i = 0u; i < simulations.size(); ++i) {
+        tasks.push_back([&simulations, &streams, i, timesteps]() {
+            RandomScope scope(&streams[i]);
+            simulations[i]->run(timesteps);
+        });
+    }
+    if (threads > 1) {
+        ThreadPool pool(threads);
+        run_tasks(&pool, tasks);
+    } else {
+        run_tasks(nullptr, tasks);
+    }
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<ThreadPool> create_thread_pool(size_t threads) {
+    return Rcpp::XPtr<ThreadPool>(new ThreadPool(threads), true);
+}
+
+//[[Rcpp::export]]
+void update_and_resize_native(
+    const Rcpp::List variables,
+    const Rcpp::List events,
+    const Rcpp::List populations,
+    Rcpp::XPtr<ThreadPool> pool,
+    SEXP profiler,
+    SEXP tracer,
+    size_t timestep
+    ) {
+    auto simulation = Simulation();
+    simulation.set_profiler(as_profiler(profiler));
+    simulation.set_tracer(as_tracer(tracer));
+    for (auto i = 0; i < events.size(); ++i) {
+        simulation.add_event(
+            Rcpp::XPtr<TargetedEvent>(SEXP(events[i])).get(),
+            std::vector<listener_t>()
+        );
+    }
+    for (auto i = 0; i < variables.size(); ++i) {
+        simulation.add_variable(Rcpp::XPtr<Variable>(SEXP(variables[i])).get());
+    }
+    for (auto i = 0; i < populations.size(); ++i) {
+        simulation.add_population(Rcpp::XPtr<Population>(SEXP(populations[i])).get());
+    }
+    simulation.update_and_resize(pool.get(), timestep);
+}
+
+//[[Rcpp::export]]
+void set_parallel_policy_native(size_t threads, size_t threshold) {
+    set_parallel_policy(threads, threshold);
+}
@@ -1,8 +1,10 @@
 #include <Rcpp.h>
 #include <testthat.h>
+#include <numeric>
 #include <unordered_set>
 
 #include "../inst/include/IterableBitset.h"
+#include "../inst/include/vector_variables.h"
 
 using individual_index_t = IterableBitset<uint64_t>;
 
@@ -233,4 +235,49 @@ context("Bitset") {
         const auto expected_bitset = individual_index_t(258, {1, 257});
         expect_true(x == expected_bitset);
     }
+
+    test_that("Bitsets can be reset to a new size") {
+        auto x = individual_index_t(100, {1, 36, 73, 99});
+        x.reset(70);
+        expect_true(x.size() == 0);
+        expect_true(x.max_size() == 70);
+        x.insert(69);
+        expect_true(x == individual_index_t(70, {69}));
+        x.reset(200);
+        x.insert(199);
+        expect_true(x == individual_index_t(200, {199}));
+    }
+
+    test_that("Vectors can be compacted over word boundaries") {
+        auto values = std::vector<int>(200);
+        std::iota(values.begin(), values.end(), 0);
+        auto index = individual_index_t(200, {0, 63, 64, 65, 128, 199});
+        compact_vector(values, index);
+        expect_true(values.size() == 194);
+        expect_true(values[0] == 1);
+        expect_true(values[61] == 62);
+        expect_true(values[62] == 66);
+        expect_true(values[124] == 129);
+        expect_true(values[193] == 198);
+    }
+
+    test_that("Copies share words until one of them changes") {
+        auto a = individual_index_t(200, std::vector<size_t>{1, 70, 150});
+        auto b = a;
+        expect_true(a.words().data() == b.words().data());
+        b.insert(3);
+        expect_true(a.words().data() != b.words().data());
+        expect_true(a.size() == 3);
+        expect_true(b.size() == 4);
+        expect_true(a.find(3) == a.end());
+        auto c = a;
+        c &= individual_index_t(200, std::vector<size_t>{70});
+        expect_true(a.size() == 3);
+        expect_true(c.size() == 1);
+        auto d = a;
+        d.shrink(std::vector<size_t>{0});
+        expect_true(a.max_size() == 200);
+        expect_true(a.find(1) != a.end());
+        expect_true(d.find(0) != d.end());
+    }
 }
@@ -0,0 +1,180 @@
+#include <Rcpp.h>
+#include <testthat.h>
+
+#include "../inst/include/common_types.h"
+#include "../inst/include/CategoricalVariable.h"
+#include "../inst/include/CompactVariable.h"
+#include "../inst/include/DoubleVariable.h"
+#include "../inst/include/RaggedVariable.h"
+#include "../inst/include/TimeSinceVariable.h"
+#include "../inst/include/Event.h"
+#include <cstdio>
+
+context("Checkpoint") {
+
+    const auto path = std::string("test-checkpoint.bin");
+
+    test_that("Variables are restored with their queued updates") {
+        auto health = CategoricalVariable(
+            std::vector<std::string>{"S", "I"},
+            std::vector<std::string>(100, "S")
+        );
+        auto age = CompactDoubleVariable<float>(std::vector<double>(100, 1.));
+        auto since = TimeSinceVariable(std::vector<double>(100, 0.), .5);
+        auto history = RaggedVariable<double>(
+            std::vector<std::vector<double>>(100, std::vector<double>{1.})
+        );
+        health.queue_update("I", individual_index_t(100, std::vector<size_t>{1, 2}));
+        age.queue_update(std::vector<double>{2.}, std::vector<size_t>{3});
+        since.update();
+        history.queue_update(
+            std::vector<std::vector<double>>{{4., 5.}},
+            std::vector<size_t>{6}
+        );
+        {
+            CheckpointWriter out(path);
+            health.save(out);
+            age.save(out);
+            since.save(out);
+            history.save(out);
+            out.close();
+        }
+
+        health.update();
+        age.update();
+        since.update();
+        history.update();
+        {
+            CheckpointReader in(path);
+            health.load(in);
+            age.load(in);
+            since.load(in);
+            history.load(in);
+            in.close();
+        }
+        std::remove(path.c_str());
+
+        expect_true(health.get_size_of("I") == 0);
+        expect_true(since.get_values()[0] == .5);
+        expect_true(history.get_values()[6] == (std::vector<double>{1.}));
+        health.update();
+        age.update();
+        since.update();
+        history.update();
+        expect_true(health.get_size_of("I") == 2);
+        expect_true(age.get_values()[3] == 2.);
+        expect_true(since.get_values()[0] == 1.);
+        expect_true(history.get_values()[6] == (std::vector<double>{4., 5.}));
+    }
+
+    test_that("Targeted event schedules are restored") {
+        auto event = TargetedEvent(10);
+        event.enable_reverse_index();
+        event.schedule(individual_index_t(10, std::vector<size_t>{1, 2}), size_t(3));
+        event.schedule(individual_index_t(10, std::vector<size_t>{5}), size_t(1));
+        event.tick();
+        {
+            CheckpointWriter out(path);
+            event.save(out);
+            out.close();
+        }
+
+        event.clear_schedule(std::vector<size_t>{1, 2, 5});
+        event.tick();
+        {
+            CheckpointReader in(path);
+            event.load(in);
+            in.close();
+        }
+        std::remove(path.c_str());
+
+        expect_true(event.get_time() == 2);
+        expect_true(bitset_to_vector_internal(event.get_scheduled(), false) == (std::vector<size_t>{1, 2, 5}));
+        expect_true(event.should_trigger());
+        expect_true(bitset_to_vector_internal(event.current_target(), false) == (std::vector<size_t>{5}));
+        event.clear_schedule(std::vector<size_t>{1});
+        expect_true(bitset_to_vector_internal(event.get_scheduled(), false) == (std::vector<size_t>{2, 5}));
+    }
+
+    test_that("Restoring a different structure stops") {
+        auto age = DoubleVariable(std::vector<double>(10, 1.));
+        auto health = CategoricalVariable(
+            std::vector<std::string>{"S", "I"},
+            std::vector<std::string>(10, "S")
+        );
+        {
+            CheckpointWriter out(path);
+            age.save(out);
+            out.close();
+        }
+        {
+            CheckpointReader in(path);
+            expect_error(health.load(in));
+        }
+        {
+            CheckpointReader in(path);
+            expect_error(in.close());
+        }
+        std::remove(path.c_str());
+    }
+
+    test_that("Restoring an inconsistent structure stops") {
+        const auto write_variable = [&](
+            const std::vector<size_t>& update_index,
+            size_t shrink_size
+        ) {
+            CheckpointWriter out(path);
+            out.write_tag("NumericVariable");
+            out.write_type<double>();
+            out.write_type<double>();
+            out.write(std::vector<double>(3, 1.));
+            out.write(uint64_t(1));
+            out.write(std::vector<double>{2.});
+            out.write(update_index);
+            out.write(individual_index_t(shrink_size));
+            out.write(std::vector<double>());
+            Tombstones().save(out);
+            out.close();
+        };
+        auto age = DoubleVariable(std::vector<double>(3, 0.));
+        write_variable(std::vector<size_t>{2}, 3);
+        {
+            CheckpointReader in(path);
+            age.load(in);
+            age.update();
+            expect_true(age.get_values() == (std::vector<double>{1., 1., 2.}));
+        }
+        write_variable(std::vector<size_t>{3}, 3);
+        {
+            CheckpointReader in(path);
+            expect_error(age.load(in));
+        }
+        write_variable(std::vector<size_t>{2}, 5);
+        {
+            CheckpointReader in(path);
+            expect_error(age.load(in));
+        }
+        std::remove(path.c_str());
+    }
+
+    test_that("A length longer than the checkpoint stops before it is allocated") {
+        {
+            CheckpointWriter out(path);
+            out.write(uint64_t(1) << 60);
+            out.write(uint64_t(0));
+            out.close();
+        }
+        {
+            CheckpointReader in(path);
+            auto values = std::vector<double>();
+            expect_error(in.read(values));
+            expect_true(values.empty());
+        }
+        {
+            CheckpointReader in(path);
+            auto value = std::string();
+            expect_error(in.read(value));
+        }
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,77 @@
+#include <Rcpp.h>
+#include <testthat.h>
+
+#include "../inst/include/common_types.h"
+#include "../inst/include/CategoricalVariable.h"
+#include "../inst/include/DoubleVariable.h"
+#include "../inst/include/RaggedVariable.h"
+#include "../inst/include/Event.h"
+
+context("Fork") {
+
+    test_that("Cloned variables share values until they are updated") {
+        auto variable = DoubleVariable(std::vector<double>(100, 1.));
+        auto clone = std::unique_ptr<DoubleVariable>(
+            static_cast<DoubleVariable*>(variable.clone())
+        );
+        expect_true(
+            variable.get_values_view()->data() == clone->get_values_view()->data()
+        );
+        clone->queue_update(std::vector<double>{2.}, std::vector<size_t>{5});
+        clone->update();
+        expect_true(
+            variable.get_values_view()->data() != clone->get_values_view()->data()
+        );
+        expect_true(variable.get_values()[5] == 1.);
+        expect_true(clone->get_values()[5] == 2.);
+    }
+
+    test_that("Cloned categorical variables only copy the categories which change") {
+        auto variable = CategoricalVariable(
+            std::vector<std::string>{"S", "I", "R"},
+            std::vector<std::string>(100, "S")
+        );
+        auto clone = std::unique_ptr<CategoricalVariable>(
+            static_cast<CategoricalVariable*>(variable.clone())
+        );
+        clone->queue_update("I", individual_index_t(100, std::vector<size_t>{1, 2}));
+        clone->update();
+        expect_true(variable.get_size_of("S") == 100);
+        expect_true(clone->get_size_of("S") == 98);
+        expect_true(clone->get_size_of("I") == 2);
+        expect_true(
+            variable.get_index_of("R").words().data() ==
+            clone->get_index_of("R").words().data()
+        );
+    }
+
+    test_that("Cloned ragged variables are independent") {
+        auto variable = RaggedVariable<double>(
+            std::vector<std::vector<double>>(10, std::vector<double>{1., 2.})
+        );
+        auto clone = std::unique_ptr<RaggedVariable<double>>(
+            static_cast<RaggedVariable<double>*>(variable.clone())
+        );
+        clone->queue_update(
+            std::vector<std::vector<double>>{{3.}},
+            std::vector<size_t>{4}
+        );
+        clone->update();
+        expect_true(variable.get_values()[4] == (std::vector<double>{1., 2.}));
+        expect_true(clone->get_values()[4] == std::vector<double>{3.});
+        expect_true(clone->get_values()[5] == (std::vector<double>{1., 2.}));
+    }
+
+    test_that("Cloned targeted events keep their own schedules") {
+        auto event = TargetedEvent(1000);
+        auto everyone = individual_index_t(1000);
+        everyone.inverse();
+        event.schedule(everyone, 2.);
+        auto clone = std::unique_ptr<TargetedEvent>(
+            static_cast<TargetedEvent*>(event.clone())
+        );
+        clone->clear_schedule(individual_index_t(1000, std::vector<size_t>{0, 1}));
+        expect_true(event.get_scheduled().size() == 1000);
+        expect_true(clone->get_scheduled().size() == 998);
+    }
+}
@@ -0,0 +1,99 @@
+#include <Rcpp.h>
+#include <testthat.h>
+
+#include "../inst/include/common_types.h"
+#include "../inst/include/CategoricalVariable.h"
+#include "../inst/include/Simulation.h"
+#include "../inst/include/Profiler.h"
+#include "../inst/include/Tracer.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+context("Profiler") {
+
+    test_that("New and copied-on-write bitsets are counted") {
+        const auto before = bitset_allocations();
+        auto a = individual_index_t(100);
+        auto b = a;
+        expect_true(bitset_allocations() == before + 1);
+        b.insert(1);
+        expect_true(bitset_allocations() == before + 2);
+        b.insert(2);
+        expect_true(bitset_allocations() == before + 2);
+    }
+
+    test_that("The simulation loop measures each part of each timestep") {
+        auto health = CategoricalVariable(
+            std::vector<std::string>{"S", "I"},
+            std::vector<std::string>(10, "S")
+        );
+        Profiler profiler;
+        profiler.name_processes(std::vector<std::string>{"infection"});
+        profiler.name_structure(&health, "health");
+        auto simulation = Simulation();
+        simulation.add_process([&health](size_t t) {
+            health.queue_update("I", individual_index_t(10, std::vector<size_t>{t}));
+            health.queue_update("I", individual_index_t(10, std::vector<size_t>{t + 1}));
+        });
+        simulation.add_variable(&health);
+        simulation.set_profiler(&profiler);
+        simulation.run(2);
+
+        const auto& records = profiler.get_records();
+        expect_true(records.size() == 6);
+        expect_true(records[0].timestep == 1);
+        expect_true(records[0].phase == "process");
+        expect_true(records[0].name == "infection");
+        expect_true(records[0].bitset_allocations == 2);
+        expect_true(records[1].phase == "update");
+        expect_true(records[1].name == "health");
+        expect_true(records[1].queued_updates == 2);
+        expect_true(records[2].phase == "resize");
+        expect_true(records[5].timestep == 2);
+        for (const auto& record : records) {
+            expect_true(record.seconds >= 0);
+        }
+    }
+
+    test_that("The simulation loop traces each part of each timestep") {
+        auto health = CategoricalVariable(
+            std::vector<std::string>{"S", "I"},
+            std::vector<std::string>(10, "S")
+        );
+        Tracer tracer;
+        tracer.name_processes(std::vector<std::string>{"infection \"a\""});
+        tracer.name_structure(&health, "health");
+        auto simulation = Simulation();
+        simulation.set_threads(2);
+        simulation.add_process([&health](size_t t) {
+            health.queue_update("I", individual_index_t(10, std::vector<size_t>{t}));
+        });
+        simulation.add_variable(&health);
+        simulation.set_tracer(&tracer);
+        simulation.run(2);
+
+        // timestep, 4 phases, process, update and resize on each timestep
+        expect_true(tracer.size() == 2 * 2 * 8);
+        const auto path = std::string("test-trace.json");
+        tracer.write(path);
+        std::ifstream in(path);
+        std::stringstream contents;
+        contents << in.rdbuf();
+        in.close();
+        std::remove(path.c_str());
+        const auto json = contents.str();
+        const auto count = [&json](const std::string& pattern) {
+            auto n = 0u;
+            for (auto i = json.find(pattern); i != std::string::npos; i = json.find(pattern, i + 1)) {
+                ++n;
+            }
+            return n;
+        };
+        expect_true(count("\"ph\":\"B\"") == 16);
+        expect_true(count("\"ph\":\"E\"") == 16);
+        expect_true(count("\"name\":\"infection \\\"a\\\"\"") == 2);
+        expect_true(count("\"cat\":\"update\"") == 2);
+        expect_true(json.find("\"traceEvents\"") != std::string::npos);
+    }
+}
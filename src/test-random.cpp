@@ -0,0 +1,87 @@
+#include <Rcpp.h>
+#include <testthat.h>
+#include <numeric>
+
+#include "../inst/include/Random.h"
+
+context("Random") {
+
+    test_that("Generators with the same seed give the same draws") {
+        auto a = Xoshiro256(42);
+        auto b = Xoshiro256(42);
+        auto c = Xoshiro256(43);
+        auto same = true;
+        auto different = false;
+        for (auto i = 0; i < 100; ++i) {
+            const auto x = a();
+            same = same && x == b();
+            different = different || x != c();
+        }
+        expect_true(same);
+        expect_true(different);
+    }
+
+    test_that("Jumped streams differ from the stream they came from") {
+        auto a = Xoshiro256(42);
+        auto b = a;
+        b.jump();
+        auto different = false;
+        for (auto i = 0; i < 100; ++i) {
+            different = different || a() != b();
+        }
+        expect_true(different);
+    }
+
+    test_that("Uniform draws are in (0, 1)") {
+        auto random = Xoshiro256(1);
+        const auto draws = random.uniform(10000);
+        expect_true(std::all_of(draws.cbegin(), draws.cend(), [](double x) {
+            return x > 0 && x < 1;
+        }));
+        const auto mean = std::accumulate(draws.cbegin(), draws.cend(), 0.) / draws.size();
+        expect_true(std::abs(mean - .5) < .02);
+    }
+
+    test_that("Binomial draws have the right mean") {
+        auto random = Xoshiro256(1);
+        for (auto p : { .01, .3, .5, .9 }) {
+            const auto draws = random.binomial(10000, 100, p);
+            const auto mean = std::accumulate(draws.cbegin(), draws.cend(), 0.) / draws.size();
+            expect_true(std::abs(mean - 100 * p) < .5);
+            expect_true(*std::max_element(draws.cbegin(), draws.cend()) <= 100);
+        }
+        expect_true(random.binomial(10, 0.) == 0);
+        expect_true(random.binomial(10, 1.) == 10);
+        expect_true(random.binomial(0, .5) == 0);
+    }
+
+    test_that("Multinomial draws add up to the number of trials") {
+        auto random = Xoshiro256(1);
+        const auto counts = random.multinomial(1000, { 1, 2, 0, 3 });
+        expect_true(std::accumulate(counts.cbegin(), counts.cend(), size_t(0)) == 1000);
+        expect_true(counts[2] == 0);
+    }
+
+    test_that("Samples are sorted and distinct") {
+        auto random = Xoshiro256(1);
+        for (auto k : { 0, 1, 5, 15, 20 }) {
+            const auto sample = random.sample(20, k);
+            expect_true(sample.size() == static_cast<size_t>(k));
+            expect_true(std::adjacent_find(
+                sample.cbegin(),
+                sample.cend(),
+                std::greater_equal<size_t>()
+            ) == sample.cend());
+            expect_true(sample.empty() || sample.back() < 20);
+        }
+    }
+
+    test_that("R's generator cannot be used from a pool task") {
+        use_r_random();
+        ThreadPool pool(2);
+        expect_error(pool.run({
+            []() { random_uniform(1); },
+            []() { random_binomial(1, .5); }
+        }));
+    }
+}
@@ -0,0 +1,49 @@
+#include <Rcpp.h>
+#include <testthat.h>
+
+#include "../inst/include/TimingWheel.h"
+#include "../inst/include/Event.h"
+
+context("Schedule") {
+
+    test_that("Schedule slots are sorted and distinct however individuals arrive") {
+        auto slot = ScheduleSlot(1000);
+        for (auto i : std::vector<size_t>{5, 2, 9, 2, 0, 5}) {
+            slot.insert(i);
+        }
+        const auto& read = slot;
+        auto seen = std::vector<size_t>();
+        read.for_each([&](size_t i) { seen.push_back(i); });
+        expect_true(seen == (std::vector<size_t>{0, 2, 5, 9}));
+        expect_true(read.size() == 4);
+        expect_true(read.contains(9));
+        expect_false(read.contains(3));
+        slot.erase(size_t(2));
+        expect_true(read.size() == 3);
+        expect_false(read.contains(2));
+    }
+
+    test_that("Schedule slots become bitsets once they are dense") {
+        auto slot = ScheduleSlot(128);
+        for (auto i = size_t(10); i > 0; --i) {
+            slot.insert(i);
+        }
+        expect_true(slot.size() == 10);
+        auto seen = std::vector<size_t>();
+        slot.for_each([&](size_t i) { seen.push_back(i); });
+        expect_true(seen.front() == 1);
+        expect_true(seen.back() == 10);
+    }
+
+    test_that("Targeted events give listeners a reference to the current target") {
+        auto event = TargetedEvent(10);
+        event.schedule(std::vector<size_t>{3, 7}, std::vector<double>{0, 1});
+        individual_index_t& target = event.current_target();
+        expect_true(bitset_to_vector_internal(target, false) == (std::vector<size_t>{3}));
+        target.insert(4);
+        expect_true(bitset_to_vector_internal(event.get_scheduled(), false) == (std::vector<size_t>{3, 7}));
+        event.tick();
+        expect_true(&event.current_target() == &target);
+        expect_true(bitset_to_vector_internal(target, false) == (std::vector<size_t>{7}));
+    }
+}
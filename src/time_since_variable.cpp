@@ -0,0 +1,19 @@
+/*
+ * time_since_variable.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+
+#include "../inst/include/TimeSinceVariable.h"
+
+//[[Rcpp::export]]
+Rcpp::XPtr<DoubleVariable> create_time_since_variable(
+    const std::vector<double>& values,
+    const double dt
+    ) {
+    return Rcpp::XPtr<DoubleVariable>(
+        new TimeSinceVariable(values, dt),
+        true
+    );
+}
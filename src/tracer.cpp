@@ -0,0 +1,43 @@
+/*
+ * tracer.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "../inst/include/Tracer.h"
+#include <algorithm>
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Tracer> create_tracer() {
+    return Rcpp::XPtr<Tracer>(new Tracer(), true);
+}
+
+//[[Rcpp::export]]
+void tracer_trace(
+    Rcpp::XPtr<Tracer> tracer,
+    size_t timestep,
+    const std::string category,
+    const std::string name,
+    Rcpp::Function f
+    ) {
+    // the category must outlive the tracer, so only the loop's own are used
+    static const auto categories = std::vector<std::string>{
+        "loop", "process", "listener", "update", "resize"
+    };
+    const auto it = std::find(categories.cbegin(), categories.cend(), category);
+    if (it == categories.cend()) {
+        Rcpp::stop("unknown trace category: " + category);
+    }
+    TraceScope scope(tracer.get(), it->c_str(), name, timestep);
+    f();
+}
+
+//[[Rcpp::export]]
+size_t tracer_size(Rcpp::XPtr<Tracer> tracer) {
+    return tracer->size();
+}
+
+//[[Rcpp::export]]
+void tracer_write(Rcpp::XPtr<Tracer> tracer, const std::string path) {
+    tracer->write(path);
+}
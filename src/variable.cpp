@@ -23,3 +23,29 @@ void variable_update(Rcpp::XPtr<Variable> variable) {
 void variable_resize(Rcpp::XPtr<Variable> variable) {
     variable->resize();
 }
+
+//[[Rcpp::export]]
+void variable_enable_tombstones(Rcpp::XPtr<Variable> variable, double threshold) {
+    variable->enable_tombstones(threshold);
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<individual_index_t> variable_get_free(Rcpp::XPtr<Variable> variable) {
+    const auto& tombstones = variable->get_tombstones();
+    return Rcpp::XPtr<individual_index_t>(
+        tombstones.enabled() ?
+            new individual_index_t(tombstones.get_free()) :
+            new individual_index_t(variable->size()),
+        true
+    );
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<Variable> variable_clone(Rcpp::XPtr<Variable> variable) {
+    return Rcpp::XPtr<Variable>(variable->clone(), true);
+}
+
+//[[Rcpp::export]]
+size_t variable_get_queue_size(Rcpp::XPtr<Variable> variable) {
+    return variable->get_queue_size();
+}
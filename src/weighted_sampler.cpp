@@ -0,0 +1,43 @@
+/*
+ * weighted_sampler.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+
+#include "../inst/include/WeightedSampler.h"
+
+//[[Rcpp::export]]
+Rcpp::XPtr<WeightedSampler> create_weighted_sampler(
+    Rcpp::XPtr<DoubleVariable> variable
+    ) {
+    return Rcpp::XPtr<WeightedSampler>(
+        new WeightedSampler(*variable),
+        true
+    );
+}
+
+//[[Rcpp::export]]
+std::vector<size_t> weighted_sampler_sample_with_replacement(
+    Rcpp::XPtr<WeightedSampler> sampler,
+    Rcpp::XPtr<individual_index_t> index,
+    const size_t k
+    ) {
+    auto result = sampler->sample_with_replacement(*index, k);
+    for (auto& i : result) {
+        ++i;
+    }
+    return result;
+}
+
+//[[Rcpp::export]]
+Rcpp::XPtr<individual_index_t> weighted_sampler_sample_without_replacement(
+    Rcpp::XPtr<WeightedSampler> sampler,
+    Rcpp::XPtr<individual_index_t> index,
+    const size_t k
+    ) {
+    return Rcpp::XPtr<individual_index_t>(
+        new individual_index_t(sampler->sample_without_replacement(*index, k)),
+        true
+    );
+}